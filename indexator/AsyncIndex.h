@@ -0,0 +1,217 @@
+#ifndef ASYNC_INDEX_H
+#define ASYNC_INDEX_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <future>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <algorithm>
+#include "Element.h"
+#include "Index.h"
+#include "ConcurrentIndex.h"
+#include "ThreadPool.h"
+
+// Interface asynchrone d'un index partagé, pour une boucle d'événements qui ne doit jamais
+// bloquer. Chaque opération s'exécute sur la réserve de threads et existe en deux formes :
+// l'une retourne un std::future, l'autre appelle un rappel avec le résultat (depuis un
+// thread de la réserve : au rappel de repasser la main à la boucle si nécessaire).
+// Les résultats sont des copies, jamais affichés. Les parcours d'intervalle et les lots de
+// modifications sont découpés en morceaux de chunkSize nœuds ou opérations, chacun soumis
+// comme une nouvelle tâche : une longue opération ne monopolise pas un thread.
+template <typename K, typename V>
+class AsyncIndex {
+public:
+    using Elements = std::vector<Element<K, V>>;
+
+    // Modification d'un lot
+    struct Mutation {
+        enum class Type {
+            ADD,           // Ajoute (key, value)
+            REMOVE,        // Supprime un élément égal à (key, value)
+            REMOVE_NODE    // Supprime le nœud key
+        };
+
+        Type type = Type::ADD;
+        K key{};
+        V value{};
+    };
+
+    // Bilan d'un lot de modifications
+    struct MutationSummary {
+        int added = 0;
+        int removed = 0;        // Éléments supprimés, nœuds supprimés compris
+        int nodesRemoved = 0;
+    };
+
+    explicit AsyncIndex(ThreadPool& pool = ThreadPool::instance(), size_t chunkSize = 256)
+        : chunkSize(std::max<size_t>(1, chunkSize)), tasks(pool) {}
+
+    // Destructeur : attend la fin des opérations en cours, en exécutant au besoin leurs
+    // tâches pas encore démarrées (jamais celles d'autres utilisateurs de la réserve)
+    ~AsyncIndex() {
+        tasks.wait();
+    }
+
+    AsyncIndex(const AsyncIndex&) = delete;
+    AsyncIndex& operator=(const AsyncIndex&) = delete;
+
+    // Index sous-jacent, pour les opérations synchrones
+    ConcurrentIndex<K, V>& index() {
+        return shared;
+    }
+
+    // Charge un fichier dans un index neuf puis le substitue à l'index courant
+    void loadAsync(const std::string& filename, std::function<void(bool)> done, LoadProgress* progress = nullptr) {
+        submit([this, filename, done = std::move(done), progress]() {
+            done(shared.loadFromFile(filename, progress));
+        });
+    }
+
+    std::future<bool> loadAsync(const std::string& filename, LoadProgress* progress = nullptr) {
+        auto promise = makePromise<bool>();
+        loadAsync(filename, promise.second, progress);
+        return std::move(promise.first);
+    }
+
+    // Éléments d'une clé
+    void getAsync(const K& key, std::function<void(Elements)> done) {
+        submit([this, key, done = std::move(done)]() {
+            done(shared.getElements(key));
+        });
+    }
+
+    std::future<Elements> getAsync(const K& key) {
+        auto promise = makePromise<Elements>();
+        getAsync(key, promise.second);
+        return std::move(promise.first);
+    }
+
+    // Éléments de clé dans [lo, hi], lus sur un instantané pris au début du parcours
+    void rangeAsync(const K& lo, const K& hi, std::function<void(Elements)> done) {
+        auto scan = std::make_shared<RangeScan>();
+        scan->lo = lo;
+        scan->hi = hi;
+        scan->done = std::move(done);
+        submit([this, scan]() {
+            scan->view = shared.snapshot();
+            continueScan(scan);
+        });
+    }
+
+    std::future<Elements> rangeAsync(const K& lo, const K& hi) {
+        auto promise = makePromise<Elements>();
+        rangeAsync(lo, hi, promise.second);
+        return std::move(promise.first);
+    }
+
+    // Applique un lot de modifications, dans l'ordre. Le lot n'est pas atomique : les autres
+    // opérations peuvent en voir une partie seulement.
+    void applyAsync(std::vector<Mutation> mutations, std::function<void(MutationSummary)> done) {
+        auto batch = std::make_shared<MutationBatch>();
+        batch->mutations = std::move(mutations);
+        batch->done = std::move(done);
+        submit([this, batch]() { continueBatch(batch); });
+    }
+
+    std::future<MutationSummary> applyAsync(std::vector<Mutation> mutations) {
+        auto promise = makePromise<MutationSummary>();
+        applyAsync(std::move(mutations), promise.second);
+        return std::move(promise.first);
+    }
+
+private:
+    struct RangeScan {
+        K lo{};
+        K hi{};
+        std::shared_ptr<const Index<K, V>> view;
+        size_t position = 0;
+        Elements result;
+        std::function<void(Elements)> done;
+    };
+
+    struct MutationBatch {
+        std::vector<Mutation> mutations;
+        size_t next = 0;
+        MutationSummary summary;
+        std::function<void(MutationSummary)> done;
+    };
+
+    ConcurrentIndex<K, V> shared;
+    size_t chunkSize;
+    TaskGroup tasks;   // Tâches des opérations, suites comprises
+
+    template <typename R>
+    static std::pair<std::future<R>, std::function<void(R)>> makePromise() {
+        auto promise = std::make_shared<std::promise<R>>();
+        std::future<R> future = promise->get_future();
+        return {std::move(future), [promise](R result) { promise->set_value(std::move(result)); }};
+    }
+
+    // Soumet une tâche ; la suite d'une opération est soumise avant la fin de la tâche
+    // courante, donc le groupe n'est jamais vide tant qu'une opération est en cours
+    void submit(std::function<void()> task) {
+        tasks.run(std::move(task));
+    }
+
+    // Un morceau du parcours, puis la suite dans une nouvelle tâche
+    void continueScan(std::shared_ptr<RangeScan> scan) {
+        std::vector<Element<K, V>*> chunk;
+        scan->position = scan->view->scanRange(scan->lo, scan->hi, scan->position, chunkSize, chunk);
+        for (const auto* element : chunk) {
+            scan->result.push_back(*element);
+        }
+        if (scan->position == Index<K, V>::ScanEnd) {
+            scan->view.reset();
+            scan->done(std::move(scan->result));
+            return;
+        }
+        submit([this, scan]() { continueScan(scan); });
+    }
+
+    // Un morceau du lot (les ajouts consécutifs sont insérés en un seul insertBatch), puis la suite
+    void continueBatch(std::shared_ptr<MutationBatch> batch) {
+        size_t end = std::min(batch->mutations.size(), batch->next + chunkSize);
+        std::vector<std::pair<K, V>> additions;
+        for (size_t i = batch->next; i < end; ++i) {
+            const Mutation& mutation = batch->mutations[i];
+            if (mutation.type == Mutation::Type::ADD) {
+                additions.emplace_back(mutation.key, mutation.value);
+                continue;
+            }
+            flushAdditions(additions, batch->summary);
+            if (mutation.type == Mutation::Type::REMOVE) {
+                if (shared.deleteElement(Element<K, V>(mutation.key, mutation.value))) {
+                    ++batch->summary.removed;
+                }
+            } else {
+                int size = static_cast<int>(shared.getElements(mutation.key).size());
+                if (shared.deleteNode(mutation.key)) {
+                    batch->summary.removed += size;
+                    ++batch->summary.nodesRemoved;
+                }
+            }
+        }
+        flushAdditions(additions, batch->summary);
+
+        batch->next = end;
+        if (batch->next == batch->mutations.size()) {
+            batch->done(batch->summary);
+            return;
+        }
+        submit([this, batch]() { continueBatch(batch); });
+    }
+
+    void flushAdditions(std::vector<std::pair<K, V>>& additions, MutationSummary& summary) {
+        if (!additions.empty()) {
+            shared.insertBatch(additions);
+            summary.added += static_cast<int>(additions.size());
+            additions.clear();
+        }
+    }
+};
+
+#endif // ASYNC_INDEX_H
@@ -0,0 +1,102 @@
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+#include <iostream>
+#include <string>
+#include <charconv>
+#include <type_traits>
+#include <system_error>
+
+// Ajoute la représentation textuelle d'une valeur à out.
+// Les nombres sont formatés avec std::to_chars, sans passer par les locales d'un flux.
+inline void appendText(std::string& out, const std::string& text) {
+    out += text;
+}
+
+inline void appendText(std::string& out, const char* text) {
+    out += text;
+}
+
+inline void appendText(std::string& out, char c) {
+    out += c;
+}
+
+template <typename T, typename = std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>>
+void appendText(std::string& out, T value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, static_cast<size_t>(result.ptr - digits));
+}
+
+// Réels : trois décimales
+inline void appendText(std::string& out, double value) {
+    char digits[64];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, 3);
+    if (result.ec != std::errc()) {
+        result = std::to_chars(digits, digits + sizeof(digits), value);   // Trop grand : notation courte
+    }
+    out.append(digits, static_cast<size_t>(result.ptr - digits));
+}
+
+// Écriture tamponnée vers un flux : les sorties sont accumulées dans un tampon d'environ
+// capacity octets, écrit d'un seul bloc quand il est plein, par flush() ou à la destruction.
+class BufferedWriter {
+public:
+    explicit BufferedWriter(std::ostream& os, size_t capacity = 1 << 20)
+        : os(os), capacity(capacity) {
+        buffer.reserve(capacity);
+    }
+
+    ~BufferedWriter() {
+        flush();
+    }
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    // Tout type accepté par appendText
+    template <typename T>
+    BufferedWriter& operator<<(const T& value) {
+        appendText(buffer, value);
+        if (buffer.size() >= capacity) {
+            writeBuffer();
+        }
+        return *this;
+    }
+
+    BufferedWriter& write(const char* data, size_t size) {
+        if (buffer.size() + size > capacity) {
+            writeBuffer();
+            if (size > capacity) {
+                os.write(data, static_cast<std::streamsize>(size));
+                return *this;
+            }
+        }
+        buffer.append(data, size);
+        return *this;
+    }
+
+    BufferedWriter& write(const std::string& text) {
+        return write(text.data(), text.size());
+    }
+
+    // Écrit le tampon et vide le flux
+    void flush() {
+        writeBuffer();
+        os.flush();
+    }
+
+private:
+    std::ostream& os;
+    size_t capacity;
+    std::string buffer;
+
+    void writeBuffer() {
+        if (!buffer.empty()) {
+            os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+};
+
+#endif // BUFFERED_WRITER_H
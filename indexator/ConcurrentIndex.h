@@ -0,0 +1,248 @@
+#ifndef CONCURRENT_INDEX_H
+#define CONCURRENT_INDEX_H
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <string>
+#include <mutex>
+#include <shared_mutex>
+#include <functional>
+#include <memory>
+#include "Element.h"
+#include "Node.h"
+#include "Index.h"
+
+// Index partagé entre plusieurs threads.
+// Deux niveaux de verrous lecteurs/rédacteur :
+//  - le répertoire des nœuds : partagé pour toute opération, exclusif quand un nœud
+//    est créé ou retiré (ou pour les opérations groupées) ;
+//  - les nœuds : un verrou par groupe de clés (répartition par hachage), partagé pour
+//    lire un nœud, exclusif pour le modifier.
+// Les lectures retournent des copies des éléments, utilisables même si un autre thread
+// les supprime ensuite. Les parcours complets (affichage, statistiques) travaillent sur un
+// instantané : ils ne bloquent les rédacteurs que le temps de le prendre.
+template <typename K, typename V, size_t Stripes = 64>
+class ConcurrentIndex {
+private:
+    Index<K, V> index;
+    // Verrou du répertoire, partagé avec les instantanés qui le prennent pour se libérer
+    std::shared_ptr<std::shared_mutex> directoryMutex = std::make_shared<std::shared_mutex>();
+    mutable std::array<std::shared_mutex, Stripes> nodeMutexes; // Verrous des nœuds
+
+    std::shared_mutex& nodeMutex(const K& key) const {
+        return nodeMutexes[std::hash<K>{}(key) % Stripes];
+    }
+
+    // Copie les éléments vivants d'un nœud (nœud verrouillé par l'appelant)
+    static void copyElements(const Node<K, V>* node, std::vector<Element<K, V>>& out) {
+        if (node == nullptr) {
+            return;
+        }
+        for (const auto* element : node->getAllElements()) {
+            out.push_back(*element);
+        }
+    }
+
+public:
+    // Constructeur
+    ConcurrentIndex() {}
+
+    ConcurrentIndex(const ConcurrentIndex&) = delete;
+    ConcurrentIndex& operator=(const ConcurrentIndex&) = delete;
+
+    // Retourne le nombre total d'éléments (compteur atomique, sans verrou)
+    int getNbElements() const {
+        return index.getNbElements();
+    }
+
+    int getNbNodes() const {
+        std::shared_lock<std::shared_mutex> directory(*directoryMutex);
+        return index.getNbNodes();
+    }
+
+    // Retourne une copie des éléments correspondant à une clé
+    std::vector<Element<K, V>> getElements(const K& key) const {
+        std::vector<Element<K, V>> result;
+        std::shared_lock<std::shared_mutex> directory(*directoryMutex);
+        std::shared_lock<std::shared_mutex> node(nodeMutex(key));
+        copyElements(index.getNode(key), result);
+        return result;
+    }
+
+    // Recherche groupée : results[i] reçoit une copie des éléments de keys[i]
+    void multiGet(const std::vector<K>& keys, std::vector<std::vector<Element<K, V>>>& results) const {
+        results.resize(keys.size());
+        std::shared_lock<std::shared_mutex> directory(*directoryMutex);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            results[i].clear();
+            std::shared_lock<std::shared_mutex> node(nodeMutex(keys[i]));
+            copyElements(index.getNode(keys[i]), results[i]);
+        }
+    }
+
+    // Indique si la clé est présente
+    bool contains(const K& key) const {
+        std::shared_lock<std::shared_mutex> directory(*directoryMutex);
+        std::shared_lock<std::shared_mutex> node(nodeMutex(key));
+        return index.getNode(key) != nullptr;
+    }
+
+    // Ajoute un élément (l'index en prend possession)
+    void addElement(Element<K, V>* element) {
+        const K key = element->getKey();
+        {
+            // Nœud existant et non partagé avec un instantané : seul ce nœud est modifié
+            std::shared_lock<std::shared_mutex> directory(*directoryMutex);
+            std::unique_lock<std::shared_mutex> node(nodeMutex(key));
+            if (index.getNode(key) != nullptr && !index.isNodeShared(key)) {
+                index.addElement(element);
+                return;
+            }
+        }
+
+        // Nouveau nœud : le répertoire est modifié
+        std::unique_lock<std::shared_mutex> directory(*directoryMutex);
+        index.addElement(element);
+    }
+
+    void addElement(const K& key, const V& value) {
+        addElement(new Element<K, V>(key, value));
+    }
+
+    // Supprime un élément égal à element
+    bool deleteElement(const Element<K, V>& element) {
+        Element<K, V> target(element);
+        {
+            std::shared_lock<std::shared_mutex> directory(*directoryMutex);
+            std::unique_lock<std::shared_mutex> nodeLock(nodeMutex(target.getKey()));
+            Node<K, V>* node = index.getNode(target.getKey());
+            if (node == nullptr) {
+                return false;
+            }
+
+            // Le nœud ne sera pas vidé ni copié : le répertoire n'est pas modifié
+            if (node->getNbElements() > 1 && !index.isNodeShared(target.getKey())) {
+                return index.deleteElement(&target);
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> directory(*directoryMutex);
+        return index.deleteElement(&target);
+    }
+
+    bool deleteNode(const K& key) {
+        std::unique_lock<std::shared_mutex> directory(*directoryMutex);
+        return index.deleteNode(key);
+    }
+
+    // Suppression paresseuse (voir Index::setLazyDeletion). Les compactages restent faits
+    // par l'opération qui franchit le seuil : d'un nœud sous son verrou, du répertoire sous
+    // le verrou exclusif.
+    void setLazyDeletion(bool enabled, double threshold = 0.25) {
+        std::unique_lock<std::shared_mutex> directory(*directoryMutex);
+        index.setLazyDeletion(enabled, threshold);
+    }
+
+    bool isLazyDeletion() const {
+        std::shared_lock<std::shared_mutex> directory(*directoryMutex);
+        return index.isLazyDeletion();
+    }
+
+    // Version de l'index (compteur atomique, sans verrou) : ne recule jamais, même après
+    // un chargement
+    uint64_t getVersion() const {
+        return index.getVersion();
+    }
+
+    // Éléments marqués supprimés en attente de compactage, comptés sur un instantané
+    int getNbDeleted() const {
+        return snapshot()->getNbDeleted();
+    }
+
+    // Opérations groupées : elles réorganisent le répertoire, verrou exclusif
+    template <typename Range>
+    void insertBatch(const Range& pairs) {
+        std::unique_lock<std::shared_mutex> directory(*directoryMutex);
+        index.insertBatch(pairs);
+    }
+
+    int deleteRange(const K& lo, const K& hi) {
+        std::unique_lock<std::shared_mutex> directory(*directoryMutex);
+        return index.deleteRange(lo, hi);
+    }
+
+    template <typename Predicate>
+    int deleteWhere(const K& key, Predicate pred) {
+        std::unique_lock<std::shared_mutex> directory(*directoryMutex);
+        return index.deleteWhere(key, pred);
+    }
+
+    template <typename Predicate>
+    int deleteWhere(Predicate pred) {
+        std::unique_lock<std::shared_mutex> directory(*directoryMutex);
+        return index.deleteWhere(pred);
+    }
+
+    // Remplace le contenu de l'index par celui de other, préparé hors verrou ; other reçoit
+    // l'ancien contenu, à libérer par l'appelant après le retour
+    void swap(Index<K, V>& other) {
+        std::unique_lock<std::shared_mutex> directory(*directoryMutex);
+        index.swap(other);
+    }
+
+    // Charge un fichier dans un index neuf, hors verrou, puis l'échange avec l'index courant
+    bool loadFromFile(const std::string& filename, LoadProgress* progress = nullptr) {
+        Index<K, V> loaded;
+        if (!loaded.loadFromFile(filename, progress)) {
+            return false;
+        }
+
+        swap(loaded);
+        return true;
+    }
+
+    // Relecture différentielle (voir Index::reloadFromFile) : le fichier est lu et trié hors
+    // verrou, seules les différences sont appliquées sous le verrou exclusif
+    bool reloadFromFile(const std::string& filename, ReloadSummary<K>* summary = nullptr) {
+        std::vector<std::pair<K, V>> pairs;
+        if (!Index<K, V>::readPairs(filename, pairs)) {
+            return false;
+        }
+
+        std::unique_lock<std::shared_mutex> directory(*directoryMutex);
+        index.applyDifference(pairs, summary);
+        return true;
+    }
+
+    // Instantané cohérent de l'index, lisible sans verrou pendant que les rédacteurs
+    // continuent (ils copient les nœuds partagés avant de les modifier). Il est libéré sous
+    // le verrou exclusif du répertoire : un rédacteur qui trouve ensuite un nœud non partagé
+    // le modifie sur place après la fin des lectures de l'instantané.
+    // Ne pas libérer un instantané en tenant un verrou de cet index.
+    std::shared_ptr<const Index<K, V>> snapshot() const {
+        std::shared_ptr<const Index<K, V>> view;
+        {
+            std::unique_lock<std::shared_mutex> directory(*directoryMutex);
+            view = index.snapshot();
+        }
+        std::shared_ptr<std::shared_mutex> mutex = directoryMutex;
+        const Index<K, V>* raw = view.get();
+        return std::shared_ptr<const Index<K, V>>(raw, [view, mutex](const Index<K, V>*) mutable {
+            std::unique_lock<std::shared_mutex> directory(*mutex);
+            view.reset();
+        });
+    }
+
+    IndexStats getStats() const {
+        return snapshot()->getStats();
+    }
+
+    // Affichage cohérent, sans bloquer les rédacteurs pendant l'écriture
+    friend std::ostream& operator<<(std::ostream& os, const ConcurrentIndex<K, V, Stripes>& concurrent) {
+        os << *concurrent.snapshot();
+        return os;
+    }
+};
+
+#endif // CONCURRENT_INDEX_H
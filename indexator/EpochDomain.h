@@ -0,0 +1,186 @@
+#ifndef EPOCH_DOMAIN_H
+#define EPOCH_DOMAIN_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+
+// Récupération de mémoire par époques (epoch-based reclamation).
+// Les lecteurs annoncent l'époque courante dans un emplacement qui leur est propre
+// (une ligne de cache par thread) : aucune opération atomique lecture-modification-
+// écriture sur une donnée partagée. Les rédacteurs publient une nouvelle version puis
+// confient l'ancienne à retire() ; elle est libérée quand plus aucun lecteur ne peut
+// l'utiliser.
+// Mémoire en attente : une collecte a lieu dès que les objets retirés atteignent
+// CollectThreshold objets ou CollectBytes octets. Sans lecteur en cours, l'attente reste
+// donc sous CollectBytes plus la taille du dernier objet retiré ; un lecteur qui reste
+// longtemps dans une section retient tout ce qui a été retiré depuis son entrée.
+class EpochDomain {
+public:
+    static constexpr size_t MaxThreads = 256;
+    static constexpr size_t CollectThreshold = 64;           // Objets en attente avant collecte
+    static constexpr size_t CollectBytes = size_t(1) << 20;  // Octets en attente avant collecte
+
+    // Domaine global, partagé par toutes les structures qui l'utilisent
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    // Section de lecture : les objets lus pendant la vie du Guard ne sont pas libérés
+    class Guard {
+    public:
+        Guard() : domain(EpochDomain::instance()) { domain.enter(); }
+        ~Guard() { domain.leave(); }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        EpochDomain& domain;
+    };
+
+    // Confie un objet retiré : il sera détruit quand aucun lecteur ne pourra plus le voir.
+    // bytes est la mémoire qu'il occupe, allocations propres comprises.
+    template <typename T>
+    void retire(const T* object, size_t bytes = sizeof(T)) {
+        if (object == nullptr) {
+            return;
+        }
+
+        // Les lecteurs entrés avant cet incrément peuvent encore voir l'objet
+        uint64_t epoch = globalEpoch.fetch_add(1, std::memory_order_seq_cst);
+
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        retired.push_back({epoch, const_cast<T*>(object), bytes,
+                           [](void* p) { delete static_cast<T*>(p); }});
+        retiredBytes += bytes;
+        if (retired.size() >= CollectThreshold || retiredBytes >= CollectBytes) {
+            collectLocked();
+        }
+    }
+
+    // Libère tout ce qui n'est plus visible par aucun lecteur
+    void collect() {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        collectLocked();
+    }
+
+    // Nombre d'objets retirés en attente de libération
+    size_t pendingCount() {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        return retired.size();
+    }
+
+    // Mémoire des objets retirés en attente de libération, en octets
+    size_t pendingBytes() {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        return retiredBytes;
+    }
+
+    ~EpochDomain() {
+        for (auto& item : retired) {
+            item.deleter(item.object);
+        }
+    }
+
+private:
+    static constexpr uint64_t Idle = std::numeric_limits<uint64_t>::max();
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch{Idle};   // Époque annoncée par le lecteur, Idle hors lecture
+        std::atomic<bool> used{false};       // Emplacement attribué à un thread
+    };
+
+    struct Retired {
+        uint64_t epoch;
+        void* object;
+        size_t bytes;
+        void (*deleter)(void*);
+    };
+
+    // Emplacement du thread courant, attribué à sa première lecture et rendu à sa fin
+    struct ThreadSlot {
+        Slot* slot = nullptr;
+        int depth = 0;   // Guards imbriqués
+
+        ~ThreadSlot() {
+            if (slot != nullptr) {
+                slot->epoch.store(Idle, std::memory_order_release);
+                slot->used.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    alignas(64) std::atomic<uint64_t> globalEpoch{1};
+    Slot slots[MaxThreads];
+
+    std::mutex retiredMutex;
+    std::vector<Retired> retired;
+    size_t retiredBytes = 0;
+
+    EpochDomain() {}
+
+    ThreadSlot& threadSlot() {
+        static thread_local ThreadSlot local;
+        if (local.slot == nullptr) {
+            for (auto& slot : slots) {
+                bool expected = false;
+                if (!slot.used.load(std::memory_order_relaxed)
+                    && slot.used.compare_exchange_strong(expected, true)) {
+                    local.slot = &slot;
+                    break;
+                }
+            }
+            if (local.slot == nullptr) {
+                throw std::runtime_error("EpochDomain: trop de threads lecteurs");
+            }
+        }
+        return local;
+    }
+
+    void enter() {
+        ThreadSlot& local = threadSlot();
+        if (local.depth++ > 0) {
+            return;
+        }
+        // Annonce puis barrière : un rédacteur qui ne voit pas l'annonce a forcément
+        // publié sa nouvelle version avant que ce lecteur ne la lise.
+        local.slot->epoch.store(globalEpoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void leave() {
+        ThreadSlot& local = threadSlot();
+        if (--local.depth == 0) {
+            local.slot->epoch.store(Idle, std::memory_order_release);
+        }
+    }
+
+    void collectLocked() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t oldestReader = Idle;
+        for (auto& slot : slots) {
+            uint64_t epoch = slot.epoch.load(std::memory_order_acquire);
+            if (epoch < oldestReader) {
+                oldestReader = epoch;
+            }
+        }
+
+        // Un objet retiré à l'époque e n'est visible que des lecteurs entrés à e ou avant
+        auto kept = retired.begin();
+        for (auto it = retired.begin(); it != retired.end(); ++it) {
+            if (it->epoch < oldestReader) {
+                it->deleter(it->object);
+                retiredBytes -= it->bytes;
+            } else {
+                *kept++ = *it;
+            }
+        }
+        retired.erase(kept, retired.end());
+    }
+};
+
+#endif // EPOCH_DOMAIN_H
@@ -0,0 +1,372 @@
+#ifndef EXTERNAL_BUILDER_H
+#define EXTERNAL_BUILDER_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <utility>
+#include <filesystem>
+#include "Node.h"
+#include "Index.h"
+#include "Serialization.h"
+#include "ThreadPool.h"
+
+// Bilan d'une construction externe (voir ExternalBuilder::build)
+struct ExternalBuildStats {
+    size_t lines = 0;
+    size_t errors = 0;        // Lignes mal formatées ignorées
+    size_t elements = 0;
+    size_t nodes = 0;
+    size_t runs = 0;          // Suites triées écrites sur disque (0 : tout a tenu en mémoire)
+    size_t mergePasses = 0;   // Passes de fusion intermédiaires (trop de suites à la fois)
+    uint64_t bytesRead = 0;
+    double ms = 0.0;
+
+    double megabytesPerSecond() const {
+        return ms > 0.0 ? bytesRead / 1e3 / ms : 0.0;
+    }
+};
+
+// Construction d'un instantané binaire (relu par Index::loadSnapshot) depuis un fichier
+// texte plus grand que la mémoire, par tri externe :
+//  - le fichier est analysé par tranches d'au plus memoryBytes / 2 octets de paires ;
+//    chaque tranche est triée et écrite en suite temporaire sur la réserve de threads
+//    pendant que la suivante est analysée ;
+//  - les suites sont fusionnées k-voies directement dans l'instantané, avec des passes
+//    intermédiaires si elles sont trop nombreuses pour le plafond mémoire.
+// Un fichier qui tient dans une tranche est trié et écrit sans suite temporaire. À la
+// fusion, seules les valeurs de la clé en cours sont gardées ensemble en mémoire.
+template <typename K, typename V>
+class ExternalBuilder {
+public:
+    explicit ExternalBuilder(size_t memoryBytes = size_t(256) << 20,
+                             const std::string& tempDirectory = std::filesystem::temp_directory_path().string())
+        : memoryBytes(std::max(memoryBytes, MinMemory)), tempDirectory(tempDirectory) {}
+
+    // Construit output depuis input. output est écrit dans output.tmp puis renommé ;
+    // en cas d'échec, il est inchangé et les suites temporaires sont supprimées.
+    bool build(const std::string& input, const std::string& output) {
+        auto start = std::chrono::steady_clock::now();
+        stats = ExternalBuildStats();
+        runs.clear();
+
+        std::vector<Pair> last;
+        bool built = writeRuns(input, last);
+        const std::string temporary = output + ".tmp";
+        if (built) {
+            if (runs.empty()) {
+                built = writeSnapshot(temporary, last);
+            } else {
+                built = mergePasses() && mergeIntoSnapshot(temporary);
+            }
+        }
+        removeRuns();
+        if (built && std::rename(temporary.c_str(), output.c_str()) != 0) {
+            std::cerr << "Erreur: Impossible de remplacer le fichier " << output << std::endl;
+            built = false;
+        }
+        if (!built) {
+            std::remove(temporary.c_str());
+        }
+        stats.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return built;
+    }
+
+    const ExternalBuildStats& getStats() const {
+        return stats;
+    }
+
+private:
+    using Pair = std::pair<K, V>;
+
+    static constexpr size_t MinMemory = 1 << 10;
+    static constexpr size_t IoBuffer = 1 << 20;        // Tampon de lecture et d'écriture
+    static constexpr size_t MinRunBuffer = 16 << 10;   // Tampon minimal d'une suite à la fusion
+    static constexpr size_t MaxFanIn = 256;            // Suites ouvertes à la fois
+
+    size_t memoryBytes;
+    std::string tempDirectory;
+    std::vector<std::string> runs;
+    unsigned runCounter = 0;
+    ExternalBuildStats stats;
+
+    // Suite temporaire ouverte en lecture, positionnée sur sa paire courante
+    struct RunReader {
+        std::unique_ptr<char[]> buffer;
+        std::ifstream in;
+        Pair current;
+
+        bool open(const std::string& path, size_t bufferSize) {
+            buffer.reset(new char[bufferSize]);
+            in.rdbuf()->pubsetbuf(buffer.get(), static_cast<std::streamsize>(bufferSize));
+            in.open(path, std::ios::binary);
+            return in.is_open();
+        }
+
+        bool next() {
+            return readBinary(in, current.first) && readBinary(in, current.second);
+        }
+    };
+
+    static size_t pairBytes(const Pair& pair) {
+        return sizeof(Pair) + heapBytes(pair.first) + heapBytes(pair.second);
+    }
+
+    std::string newRunPath() {
+        return (std::filesystem::path(tempDirectory)
+                / ("indexator-run-" + std::to_string(reinterpret_cast<uintptr_t>(this)) + "-"
+                   + std::to_string(++runCounter) + ".tmp")).string();
+    }
+
+    static bool writeRun(const std::string& path, const std::vector<Pair>& pairs) {
+        std::unique_ptr<char[]> buffer(new char[IoBuffer]);
+        std::ofstream out;
+        out.rdbuf()->pubsetbuf(buffer.get(), IoBuffer);
+        out.open(path, std::ios::binary | std::ios::trunc);
+        for (const auto& pair : pairs) {
+            writeBinary(out, pair.first);
+            writeBinary(out, pair.second);
+        }
+        out.close();
+        if (!out) {
+            std::cerr << "Erreur: Impossible d'écrire la suite temporaire " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // Analyse input par tranches ; les tranches pleines sont triées et écrites en suites
+    // temporaires, la dernière est laissée triée dans last
+    bool writeRuns(const std::string& input, std::vector<Pair>& last) {
+        std::unique_ptr<char[]> buffer(new char[IoBuffer]);
+        std::ifstream file;
+        file.rdbuf()->pubsetbuf(buffer.get(), IoBuffer);
+        file.open(input);
+        if (!file.is_open()) {
+            std::cerr << "Erreur: Impossible d'ouvrir le fichier " << input << std::endl;
+            return false;
+        }
+
+        // Deux tranches en mémoire : l'une analysée, l'autre triée et écrite en parallèle
+        const size_t chunkBytes = memoryBytes / 2;
+        std::atomic<bool> spilled{true};
+        TaskGroup spilling;
+        auto spill = [&](std::vector<Pair>& chunk) {
+            spilling.wait();
+            auto pairs = std::make_shared<std::vector<Pair>>(std::move(chunk));
+            chunk.clear();
+            runs.push_back(newRunPath());
+            spilling.run([pairs, path = runs.back(), &spilled]() {
+                std::sort(pairs->begin(), pairs->end());
+                if (!writeRun(path, *pairs)) {
+                    spilled = false;
+                }
+            });
+        };
+
+        std::vector<Pair> chunk;
+        size_t bytes = 0;
+        std::string line;
+        K key;
+        V value;
+        while (std::getline(file, line)) {
+            ++stats.lines;
+            stats.bytesRead += line.size() + 1;
+            if (!Index<K, V>::parseLine(line, key, value)) {
+                if (!line.empty()) {
+                    ++stats.errors;
+                }
+                continue;
+            }
+            chunk.emplace_back(key, value);
+            bytes += pairBytes(chunk.back());
+            if (bytes >= chunkBytes) {
+                spill(chunk);
+                bytes = 0;
+            }
+        }
+
+        if (!runs.empty() && !chunk.empty()) {
+            spill(chunk);
+        }
+        spilling.wait();
+        stats.runs = runs.size();
+        if (runs.empty()) {
+            std::sort(chunk.begin(), chunk.end());
+            last.swap(chunk);
+        }
+        return spilled;
+    }
+
+    // Écrit un instantané depuis des paires triées tenant en mémoire
+    bool writeSnapshot(const std::string& path, const std::vector<Pair>& pairs) {
+        SnapshotWriter writer;
+        if (!writer.open(path)) {
+            return false;
+        }
+        for (const auto& pair : pairs) {
+            writer.add(pair);
+        }
+        return writer.close(stats);
+    }
+
+    // Fusion k-voies de paths ; emit reçoit les paires dans l'ordre
+    template <typename Emit>
+    bool mergeRuns(const std::vector<std::string>& paths, Emit emit) {
+        size_t bufferSize = std::max(MinRunBuffer, std::min(IoBuffer, memoryBytes / (paths.size() + 1)));
+        std::vector<std::unique_ptr<RunReader>> readers;
+        for (const auto& path : paths) {
+            readers.push_back(std::make_unique<RunReader>());
+            if (!readers.back()->open(path, bufferSize)) {
+                std::cerr << "Erreur: Impossible de relire la suite temporaire " << path << std::endl;
+                return false;
+            }
+            if (!readers.back()->next()) {
+                readers.pop_back();   // Suite vide
+            }
+        }
+
+        auto headGreater = [](const std::unique_ptr<RunReader>& a, const std::unique_ptr<RunReader>& b) {
+            return b->current < a->current;
+        };
+        std::make_heap(readers.begin(), readers.end(), headGreater);
+        while (!readers.empty()) {
+            std::pop_heap(readers.begin(), readers.end(), headGreater);
+            RunReader& reader = *readers.back();
+            emit(reader.current);
+            if (reader.next()) {
+                std::push_heap(readers.begin(), readers.end(), headGreater);
+            } else {
+                readers.pop_back();
+            }
+        }
+        return true;
+    }
+
+    // Nombre de suites fusionnées à la fois : un tampon d'au moins MinRunBuffer chacune
+    size_t fanIn() const {
+        return std::max<size_t>(2, std::min(MaxFanIn, memoryBytes / MinRunBuffer));
+    }
+
+    // Passes intermédiaires : fusionne les plus anciennes suites tant qu'elles sont trop
+    // nombreuses pour une seule fusion
+    bool mergePasses() {
+        const size_t width = fanIn();
+        size_t first = 0;
+        while (runs.size() - first > width) {
+            std::vector<std::string> group(runs.begin() + first, runs.begin() + first + width);
+            std::string path = newRunPath();
+            runs.push_back(path);
+
+            std::unique_ptr<char[]> buffer(new char[IoBuffer]);
+            std::ofstream out;
+            out.rdbuf()->pubsetbuf(buffer.get(), IoBuffer);
+            out.open(path, std::ios::binary | std::ios::trunc);
+            bool merged = mergeRuns(group, [&out](const Pair& pair) {
+                writeBinary(out, pair.first);
+                writeBinary(out, pair.second);
+            });
+            out.close();
+            if (!merged || !out) {
+                std::cerr << "Erreur: Impossible d'écrire la suite temporaire " << path << std::endl;
+                return false;
+            }
+            for (const auto& done : group) {
+                std::remove(done.c_str());
+            }
+            first += width;
+            ++stats.mergePasses;
+        }
+        runs.erase(runs.begin(), runs.begin() + first);
+        return true;
+    }
+
+    bool mergeIntoSnapshot(const std::string& path) {
+        SnapshotWriter writer;
+        if (!writer.open(path)) {
+            return false;
+        }
+        bool merged = mergeRuns(runs, [&writer](const Pair& pair) { writer.add(pair); });
+        return writer.close(stats) && merged;
+    }
+
+    void removeRuns() {
+        for (const auto& run : runs) {
+            std::remove(run.c_str());
+        }
+        runs.clear();
+    }
+
+    // Écriture d'un instantané depuis des paires triées : les valeurs d'une clé sont
+    // regroupées en un nœud, le nombre de nœuds est reporté dans l'en-tête à la fin
+    class SnapshotWriter {
+    public:
+        bool open(const std::string& path) {
+            this->path = path;
+            out.rdbuf()->pubsetbuf(buffer.get(), IoBuffer);
+            out.open(path, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) {
+                std::cerr << "Erreur: Impossible de créer le fichier " << path << std::endl;
+                return false;
+            }
+            writeSnapshotHeader<K, V>(out, 0);
+            return true;
+        }
+
+        void add(const Pair& pair) {
+            if (!values.empty() && pair.first != key) {
+                writeNode();
+            }
+            if (values.empty()) {
+                key = pair.first;
+            }
+            values.push_back(pair.second);
+            ++elements;
+        }
+
+        bool close(ExternalBuildStats& stats) {
+            if (!values.empty()) {
+                writeNode();
+            }
+            // Nombre de nœuds : dernier champ de l'en-tête
+            out.seekp(static_cast<std::streamoff>(sizeof(SnapshotMagic) + sizeof(SnapshotVersion) + 2));
+            writeBinary(out, nodes);
+            out.close();
+            if (!out) {
+                std::cerr << "Erreur: Écriture incomplète du fichier " << path << std::endl;
+                return false;
+            }
+            stats.nodes = nodes;
+            stats.elements = elements;
+            return true;
+        }
+
+    private:
+        std::unique_ptr<char[]> buffer{new char[IoBuffer]};
+        std::ofstream out;
+        std::string path;
+        K key{};
+        std::vector<V> values;
+        uint64_t nodes = 0;
+        size_t elements = 0;
+
+        void writeNode() {
+            writeBinary(out, key);
+            writeBinary(out, static_cast<uint64_t>(values.size()));
+            for (const auto& value : values) {
+                writeBinary(out, value);
+            }
+            values.clear();
+            ++nodes;
+        }
+    };
+};
+
+#endif // EXTERNAL_BUILDER_H
@@ -0,0 +1,257 @@
+#ifndef FILE_FOLLOWER_H
+#define FILE_FOLLOWER_H
+
+#ifndef __linux__
+#error "FileFollower nécessite Linux (inotify)"
+#endif
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include <algorithm>
+#include <filesystem>
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include "Index.h"
+#include "ConcurrentIndex.h"
+
+// Suivi d'un fichier d'index alimenté par ajouts en fin, à la manière de "tail -F".
+// Après un chargement complet, seules les lignes complètes ajoutées depuis le dernier octet
+// ingéré sont analysées puis insérées d'un lot par insertBatch ; une ligne en cours
+// d'écriture (sans '\n' final) attend la suite. Le répertoire du fichier est surveillé par
+// inotify, depuis un thread lancé par start(). Un fichier tronqué, ou remplacé par un autre
+// (rotation), est relu entièrement puis échangé avec le contenu de l'index ; tant que le
+// fichier est absent, l'index est conservé.
+template <typename K, typename V>
+class FileFollower {
+public:
+    FileFollower(ConcurrentIndex<K, V>& index, const std::string& filename)
+        : index(index), filename(filename) {}
+
+    ~FileFollower() {
+        stop();
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    FileFollower(const FileFollower&) = delete;
+    FileFollower& operator=(const FileFollower&) = delete;
+
+    // Charge le fichier puis le suit en arrière-plan jusqu'à stop()
+    bool start() {
+        if (worker.joinable()) {
+            return false;
+        }
+        std::filesystem::path path(filename);
+        std::string directory = path.has_parent_path() ? path.parent_path().string() : ".";
+        name = path.filename().string();
+
+        inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        // Surveillé avant le chargement : un ajout pendant la lecture n'est pas manqué
+        if (inotifyFd < 0 || stopFd < 0
+            || inotify_add_watch(inotifyFd, directory.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE
+                                 | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE) < 0) {
+            std::cerr << "Erreur: Impossible de surveiller " << directory << ": " << std::strerror(errno) << std::endl;
+            closeDescriptors();
+            return false;
+        }
+        if (!catchUp()) {
+            closeDescriptors();
+            return false;
+        }
+        worker = std::thread([this]() { run(); });
+        return true;
+    }
+
+    // Arrête le suivi ; l'index garde ce qui a été ingéré
+    void stop() {
+        if (worker.joinable()) {
+            uint64_t one = 1;
+            ssize_t written = write(stopFd, &one, sizeof(one));
+            (void)written;
+            worker.join();
+        }
+        closeDescriptors();
+    }
+
+    // Applique ce qui a changé dans le fichier depuis le dernier passage : lignes ajoutées,
+    // ou rechargement complet après troncature ou rotation. Appelée par le thread de suivi,
+    // ou directement sans start(). Retourne false si le fichier ne peut pas être lu.
+    bool catchUp() {
+        std::lock_guard<std::mutex> lock(mutex);
+        struct stat current;
+        if (::stat(filename.c_str(), &current) != 0) {
+            return fd >= 0;   // Absent, le temps d'une rotation : on garde l'index
+        }
+
+        bool reload = fd < 0 || current.st_ino != inode || current.st_dev != device
+                      || static_cast<uint64_t>(current.st_size) < offset;
+        if (reload) {
+            int reopened = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+            if (reopened < 0 || fstat(reopened, &current) != 0) {
+                std::cerr << "Erreur: Impossible d'ouvrir le fichier " << filename << std::endl;
+                if (reopened >= 0) {
+                    close(reopened);
+                }
+                return false;
+            }
+            if (fd >= 0) {
+                close(fd);
+            }
+            fd = reopened;
+            inode = current.st_ino;
+            device = current.st_dev;
+            offset = 0;
+        }
+
+        std::vector<std::pair<K, V>> pairs;
+        uint64_t end = readLines(offset, static_cast<uint64_t>(current.st_size), pairs);
+        if (reload) {
+            Index<K, V> loaded;
+            loaded.insertBatch(pairs);
+            index.swap(loaded);
+            ++reloads;
+        } else if (!pairs.empty()) {
+            index.insertBatch(pairs);
+        }
+        ingestedLines += pairs.size();
+        offset = end;
+        ingestedBytes = end;
+        return true;
+    }
+
+    // Octets du fichier courant déjà ingérés (jusqu'à la dernière ligne complète)
+    uint64_t getOffset() const {
+        return ingestedBytes;
+    }
+
+    // Lignes insérées depuis start(), rechargements compris
+    uint64_t getIngestedLines() const {
+        return ingestedLines;
+    }
+
+    // Lignes mal formées ignorées
+    uint64_t getErrors() const {
+        return errors;
+    }
+
+    // Chargements complets (le premier compris)
+    unsigned getReloads() const {
+        return reloads;
+    }
+
+private:
+    static constexpr size_t ReadChunk = 1 << 20;
+
+    ConcurrentIndex<K, V>& index;
+    std::string filename;
+    std::string name;   // Nom du fichier dans son répertoire, pour filtrer les événements
+    int inotifyFd = -1;
+    int stopFd = -1;
+    std::thread worker;
+
+    std::mutex mutex;   // Un seul catchUp à la fois
+    int fd = -1;        // Fichier suivi, pour détecter une rotation
+    ino_t inode = 0;
+    dev_t device = 0;
+    uint64_t offset = 0;
+
+    std::atomic<uint64_t> ingestedBytes{0};
+    std::atomic<uint64_t> ingestedLines{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<unsigned> reloads{0};
+
+    // Analyse les lignes complètes de [from, to) ; retourne la position qui suit la
+    // dernière d'entre elles
+    uint64_t readLines(uint64_t from, uint64_t to, std::vector<std::pair<K, V>>& pairs) {
+        std::string data, line;
+        uint64_t position = from;
+        uint64_t consumed = from;
+        K key;
+        V value;
+        while (position < to) {
+            size_t pending = data.size();
+            size_t wanted = static_cast<size_t>(std::min<uint64_t>(ReadChunk, to - position));
+            data.resize(pending + wanted);
+            ssize_t got = pread(fd, &data[pending], wanted, static_cast<off_t>(position));
+            if (got <= 0) {
+                break;
+            }
+            data.resize(pending + static_cast<size_t>(got));
+            position += static_cast<uint64_t>(got);
+
+            size_t start = 0;
+            for (size_t newline = data.find('\n'); newline != std::string::npos; newline = data.find('\n', start)) {
+                line.assign(data, start, newline - start);
+                if (Index<K, V>::parseLine(line, key, value)) {
+                    pairs.emplace_back(key, value);
+                } else if (!line.empty()) {
+                    ++errors;
+                }
+                start = newline + 1;
+            }
+            consumed += start;
+            data.erase(0, start);   // Ligne incomplète : complétée par la tranche suivante
+        }
+        return consumed;
+    }
+
+    // Boucle du thread de suivi : un passage de catchUp par salve d'événements sur le fichier
+    void run() {
+        pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {stopFd, POLLIN, 0}};
+        alignas(inotify_event) char events[4096];
+        while (true) {
+            if (poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "Erreur: poll: " << std::strerror(errno) << std::endl;
+                return;
+            }
+            if (fds[1].revents != 0) {
+                return;
+            }
+
+            bool changed = false;
+            ssize_t size;
+            while ((size = read(inotifyFd, events, sizeof(events))) > 0) {
+                for (char* p = events; p < events + size;) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(p);
+                    if ((event->mask & IN_Q_OVERFLOW) || (event->len > 0 && name == event->name)) {
+                        changed = true;
+                    }
+                    p += sizeof(inotify_event) + event->len;
+                }
+            }
+            if (changed) {
+                catchUp();
+            }
+        }
+    }
+
+    void closeDescriptors() {
+        if (inotifyFd >= 0) {
+            close(inotifyFd);
+            inotifyFd = -1;
+        }
+        if (stopFd >= 0) {
+            close(stopFd);
+            stopFd = -1;
+        }
+    }
+};
+
+#endif // FILE_FOLLOWER_H
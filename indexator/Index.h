@@ -7,8 +7,23 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <numeric>
+#include <iterator>
+#include <chrono>
+#include <cstddef>
+#include <atomic>
+#include <utility>
+#include <memory>
+#include <cstdint>
+#include <cstdio>
+#include <charconv>
+#include <limits>
+#include <type_traits>
 #include "Node.h"
 #include "Element.h"
+#include "Serialization.h"
+#include "ThreadPool.h"
+#include "BufferedWriter.h"
 
 // Fonctions auxiliaires de conversion de types
 template <typename T>
@@ -31,75 +46,367 @@ inline char convertFromString<char>(const std::string& str) {
     return str.empty() ? '\0' : str[0];
 }
 
+// Conversion du champ [first, last) sans copie intermédiaire ; même résultat que
+// convertFromString (préfixe numérique, 0 sans chiffre, borne du type en cas de dépassement)
+template <typename T>
+void convertField(const char* first, const char* last, T& out) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        out.assign(first, last);
+    } else if constexpr (std::is_same_v<T, char>) {
+        out = first == last ? '\0' : *first;
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        if (last - first > 1 && *first == '+' && first[1] != '-') {
+            ++first;   // Accepté par la lecture par flux, pas par from_chars
+        }
+        auto result = std::from_chars(first, last, out);
+        if (result.ec == std::errc::result_out_of_range) {
+            out = *first == '-' ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+        } else if (result.ec != std::errc()) {
+            out = 0;
+        }
+    } else {
+        out = convertFromString<T>(std::string(first, last));
+    }
+}
+
+// Retire les espaces et tabulations en début et fin de [first, last)
+inline void trimField(const char*& first, const char*& last) {
+    while (first < last && (*first == ' ' || *first == '\t')) {
+        ++first;
+    }
+    while (last > first && (last[-1] == ' ' || last[-1] == '\t')) {
+        --last;
+    }
+}
+
+// Statistiques d'un index (voir Index::getStats)
+struct IndexStats {
+    int nbNodes = 0;             // Nombre de nœuds
+    int nbElements = 0;          // Nombre d'éléments
+    int nbDeleted = 0;           // Éléments marqués supprimés en attente de compactage
+    int minPerNode = 0;          // Éléments par nœud : minimum, moyenne, maximum
+    double avgPerNode = 0.0;
+    int maxPerNode = 0;
+    int p50PerNode = 0;          // Éléments par nœud : percentiles 50, 90 et 99
+    int p90PerNode = 0;
+    int p99PerNode = 0;
+    size_t directoryBytes = 0;   // Estimation mémoire : répertoire des nœuds
+    size_t nodeBytes = 0;        // Estimation mémoire : nœuds et leurs tableaux de pointeurs
+    size_t elementBytes = 0;     // Estimation mémoire : éléments (clés et valeurs comprises)
+    size_t sharedBytes = 0;      // Part des nœuds et éléments partagée avec un clone ou un instantané
+    double loadTimeMs = 0.0;     // Durée du dernier loadFromFile
+
+    size_t totalBytes() const { return directoryBytes + nodeBytes + elementBytes; }
+    size_t privateBytes() const { return totalBytes() - sharedBytes; }
+};
+
+// Position de reprise d'un parcours de l'index par pages (voir Index::collectPage)
+struct PageCursor {
+    size_t node = 0;      // Position du nœud dans le répertoire
+    size_t slot = 0;      // Emplacement dans le tableau d'éléments du nœud
+    bool done = false;    // Parcours terminé
+};
+
+// Avancement d'un chargement (voir Index::loadFromFile), lisible depuis un autre thread.
+// Mettre cancelled à true interrompt le chargement, qui échoue sans modifier l'index.
+struct LoadProgress {
+    std::atomic<size_t> totalBytes{0};    // Taille du fichier
+    std::atomic<size_t> bytesRead{0};     // Octets lus
+    std::atomic<size_t> lines{0};         // Lignes lues
+    std::atomic<size_t> errors{0};        // Lignes mal formatées ignorées
+    std::atomic<bool> cancelled{false};   // Demande d'annulation
+
+    double percent() const {
+        size_t total = totalBytes;
+        return total == 0 ? 0.0 : 100.0 * bytesRead / total;
+    }
+};
+
+// Changements appliqués par une relecture différentielle (voir Index::reloadFromFile)
+template <typename K>
+struct ReloadSummary {
+    int added = 0;              // Éléments ajoutés
+    int removed = 0;            // Éléments supprimés
+    int nodesAdded = 0;         // Nouvelles clés
+    int nodesRemoved = 0;       // Clés disparues
+    int unchanged = 0;          // Éléments conservés tels quels
+    std::vector<K> changedKeys; // Clés dont les éléments ont changé, triées (à invalider)
+
+    bool empty() const { return added == 0 && removed == 0; }
+};
+
 template <typename K, typename V>
 class Index {
 private:
-    std::vector<Node<K, V>*> nodes;    // Collection de nœuds
+    using NodePtr = std::shared_ptr<Node<K, V>>;
+
+    std::vector<NodePtr> nodes;         // Collection de nœuds (partagés avec les clones et instantanés)
+    std::atomic<uint64_t> version{0};   // Version, incrémentée à chaque modification
+
+    bool lazyDeletion = false;          // Suppression paresseuse par pierres tombales
+    double compactionThreshold = 0.25;  // Proportion de supprimés déclenchant un compactage
+    int deadNodes = 0;                  // Nœuds vidés par suppression paresseuse
+    std::atomic<int> nbElements{0};     // Nombre d'éléments vivants, tenu à jour
+                                        // (atomique : ConcurrentIndex modifie des nœuds
+                                        // distincts en parallèle)
+    double loadTimeMs = 0.0;            // Durée du dernier chargement
+
+    using NodeIterator = typename std::vector<NodePtr>::const_iterator;
+
+    static constexpr size_t ParallelSortThreshold = 1 << 16;   // Lot trié sur la réserve de threads
+
+    // Nœud vidé par une suppression paresseuse, en attente de compactage
+    static bool isRemoved(const Node<K, V>* node) {
+        return node->getNbElements() == 0 && node->getNbDeleted() > 0;
+    }
+
+    static bool isRemoved(const NodePtr& node) {
+        return isRemoved(node.get());
+    }
+
+    // Position du premier nœud de clé >= key (nœuds marqués supprimés compris)
+    typename std::vector<NodePtr>::iterator lowerBoundNode(const K& key) {
+        return std::lower_bound(nodes.begin(), nodes.end(), key,
+                                [](const NodePtr& node, const K& k) {
+                                    return node->getKey() < k;
+                                });
+    }
+
+    // Position du nœud vivant de clé key, ou end()
+    typename std::vector<NodePtr>::iterator findLiveNode(const K& key) {
+        auto it = lowerBoundNode(key);
+        if (it != nodes.end() && (*it)->getKey() == key && !isRemoved(*it)) {
+            return it;
+        }
+        return nodes.end();
+    }
+
+    // Rend modifiable le nœud en position it : s'il est partagé avec un clone ou un instantané,
+    // il est d'abord copié (copie sur écriture) et seule cette copie est modifiée
+    Node<K, V>* mutableNode(typename std::vector<NodePtr>::iterator it) {
+        if (it->use_count() > 1) {
+            *it = std::make_shared<Node<K, V>>(**it);
+        } else {
+            // Ordonne la modification après les lectures d'un instantané libéré par un
+            // autre thread (la libération décrémente le compteur avec sémantique release)
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return it->get();
+    }
+
+    // Retire du répertoire les nœuds vidés par suppression paresseuse
+    void compactDirectory() {
+        if (deadNodes == 0) {
+            return;
+        }
+        nodes.erase(std::remove_if(nodes.begin(), nodes.end(),
+                                   [](const NodePtr& node) {
+                                       return isRemoved(node);
+                                   }),
+                    nodes.end());
+        deadNodes = 0;
+    }
+
+    void maybeCompactDirectory() {
+        if (deadNodes > compactionThreshold * nodes.size()) {
+            compactDirectory();
+        }
+    }
+
+    // Premier nœud de clé >= key à partir de from (recherche exponentielle puis dichotomique).
+    // Efficace pour des sondes croissantes : le coût dépend de la distance parcourue.
+    NodeIterator seekNode(NodeIterator from, const K& key) const {
+        auto byKey = [](const NodePtr& node, const K& k) {
+            return node->getKey() < k;
+        };
+
+        size_t step = 1;
+        while (from != nodes.end()) {
+            size_t remaining = static_cast<size_t>(nodes.end() - from);
+            NodeIterator probe = from + (std::min(step, remaining) - 1);
+            if (!((*probe)->getKey() < key)) {
+                return std::lower_bound(from, probe + 1, key, byKey);
+            }
+            from = probe + 1;
+            step *= 2;
+        }
+        return from;
+    }
 
 public:
     // Constructeur
     Index() {}
 
-    // Destructeur - libère la mémoire pour tous les nœuds
+    // Destructeur - les nœuds sont libérés avec leur dernier propriétaire
+    // (cet index ou un instantané)
     ~Index() {
-        for (auto node : nodes) {
-            delete node;
-        }
         nodes.clear();
     }
 
-    // Retourne le nombre total d'éléments dans l'index
+    // Pas de copie implicite : voir clone() et snapshot()
+    Index(const Index&) = delete;
+    Index& operator=(const Index&) = delete;
+
+    // Échange le contenu de deux index en O(1). Les réglages (suppression paresseuse, seuil
+    // de compactage) restent à leur index ; les deux versions avancent au-delà de la plus
+    // grande, pour qu'aucune ne recule. Un index en suppression immédiate qui reçoit des
+    // éléments marqués supprimés est compacté (O(n), seulement si les modes diffèrent).
+    void swap(Index<K, V>& other) {
+        nodes.swap(other.nodes);
+        std::swap(deadNodes, other.deadNodes);
+        std::swap(loadTimeMs, other.loadTimeMs);
+        int count = nbElements;
+        nbElements = other.nbElements.load();
+        other.nbElements = count;
+        uint64_t next = std::max(version.load(), other.version.load()) + 1;
+        version = next;
+        other.version = next;
+        if (lazyDeletion && !other.lazyDeletion) {
+            other.compact();
+        } else if (!lazyDeletion && other.lazyDeletion) {
+            compact();
+        }
+    }
+
+    // Clone modifiable, obtenu en O(nœuds) sans copier les éléments : les nœuds sont
+    // partagés et chacun des deux index ne copie un nœud qu'au moment de le modifier.
+    std::unique_ptr<Index<K, V>> clone() const {
+        std::unique_ptr<Index<K, V>> copy(new Index<K, V>());
+        copy->nodes = nodes;
+        copy->version = version.load();
+        copy->lazyDeletion = lazyDeletion;
+        copy->compactionThreshold = compactionThreshold;
+        copy->deadNodes = deadNodes;
+        copy->nbElements = nbElements.load();
+        copy->loadTimeMs = loadTimeMs;
+        return copy;
+    }
+
+    // Instantané : clone figé, vue cohérente de l'index. L'index copie un nœud partagé avant
+    // de le modifier, donc l'instantané ne change plus pendant que l'index évolue. Les nœuds
+    // d'une ancienne version sont libérés avec le dernier instantané qui les référence.
+    std::shared_ptr<const Index<K, V>> snapshot() const {
+        return std::shared_ptr<const Index<K, V>>(clone());
+    }
+
+    // Version de l'index (ou de l'instantané), incrémentée à chaque modification
+    uint64_t getVersion() const {
+        return version;
+    }
+
+    // Retourne le nombre total d'éléments dans l'index (tenu à jour, O(1)).
+    // Les modifications doivent passer par l'index, pas directement par un nœud.
     int getNbElements() const {
-        int count = 0;
+        return nbElements;
+    }
+
+    // Retourne le nombre de nœuds de l'index (O(1))
+    int getNbNodes() const {
+        return static_cast<int>(nodes.size()) - deadNodes;
+    }
+
+    // Calcule les statistiques de l'index (un passage sur les nœuds)
+    IndexStats getStats() const {
+        IndexStats stats;
+        stats.nbNodes = getNbNodes();
+        stats.nbElements = nbElements;
+        stats.loadTimeMs = loadTimeMs;
+        stats.directoryBytes = sizeof(*this) + nodes.capacity() * sizeof(NodePtr);
+
+        std::vector<int> perNode;
+        perNode.reserve(stats.nbNodes);
         for (const auto& node : nodes) {
-            count += node->getNbElements();
+            size_t nodeBytes = node->estimateNodeBytes();
+            size_t elementBytes = node->estimateElementBytes();
+            stats.nbDeleted += node->getNbDeleted();
+            stats.nodeBytes += nodeBytes;
+            stats.elementBytes += elementBytes;
+            if (node.use_count() > 1) {
+                stats.sharedBytes += nodeBytes + elementBytes;
+            }
+            if (!isRemoved(node)) {
+                perNode.push_back(node->getNbElements());
+            }
         }
-        return count;
+
+        if (!perNode.empty()) {
+            std::sort(perNode.begin(), perNode.end());
+            auto percentile = [&perNode](double p) {
+                return perNode[static_cast<size_t>(p * (perNode.size() - 1))];
+            };
+            stats.minPerNode = perNode.front();
+            stats.maxPerNode = perNode.back();
+            stats.avgPerNode = static_cast<double>(stats.nbElements) / perNode.size();
+            stats.p50PerNode = percentile(0.50);
+            stats.p90PerNode = percentile(0.90);
+            stats.p99PerNode = percentile(0.99);
+        }
+        return stats;
     }
 
-    // Recherche un nœud par clé
+    // Recherche un nœud par clé (recherche dichotomique, les nœuds sont triés par clé).
+    // Le nœud retourné peut être partagé avec un instantané : le modifier via l'index.
     Node<K, V>* getNode(const K& key) const {
-        auto it = std::find_if(nodes.begin(), nodes.end(),
-                             [&key](const Node<K, V>* node) {
-                                 return node->getKey() == key;
-                             });
+        auto it = std::lower_bound(nodes.begin(), nodes.end(), key,
+                                   [](const NodePtr& node, const K& k) {
+                                       return node->getKey() < k;
+                                   });
 
-        if (it != nodes.end()) {
-            return *it;
+        if (it != nodes.end() && (*it)->getKey() == key && !isRemoved(*it)) {
+            return it->get();
         }
 
         return nullptr;  // Nœud non trouvé
     }
 
+    // Indique si le nœud de clé key est partagé avec un instantané : sa prochaine
+    // modification en fera une copie
+    bool isNodeShared(const K& key) const {
+        auto it = std::lower_bound(nodes.begin(), nodes.end(), key,
+                                   [](const NodePtr& node, const K& k) {
+                                       return node->getKey() < k;
+                                   });
+        return it != nodes.end() && (*it)->getKey() == key && it->use_count() > 1;
+    }
+
     // Ajoute un nouveau nœud avec la clé spécifiée
     void addNode(const K& key) {
+        auto it = lowerBoundNode(key);
+
         // Vérifier si un nœud avec cette clé existe déjà
-        if (getNode(key) != nullptr) {
+        if (it != nodes.end() && (*it)->getKey() == key) {
+            // Un nœud marqué supprimé est réutilisé
+            if (isRemoved(*it)) {
+                mutableNode(it)->compact();
+                --deadNodes;
+                ++version;
+            }
             return;  // Ne pas ajouter de doublons
         }
 
-        // Créer et ajouter un nouveau nœud
-        Node<K, V>* newNode = new Node<K, V>(key);
-        nodes.push_back(newNode);
-
-        // Trier les nœuds par clé
-        std::sort(nodes.begin(), nodes.end(),
-                 [](const Node<K, V>* a, const Node<K, V>* b) {
-                     return a->getKey() < b->getKey();
-                 });
+        // Créer et insérer le nouveau nœud à sa place pour garder les nœuds triés par clé
+        nodes.insert(it, std::make_shared<Node<K, V>>(key));
+        ++version;
     }
 
     // Supprime un nœud par clé
     bool deleteNode(const K& key) {
-        auto it = std::find_if(nodes.begin(), nodes.end(),
-                             [&key](const Node<K, V>* node) {
-                                 return node->getKey() == key;
-                             });
+        auto it = findLiveNode(key);
 
         if (it != nodes.end()) {
-            Node<K, V>* node = *it;
+            nbElements -= (*it)->getNbElements();
+            ++version;
+
+            // En mode paresseux, le nœud est seulement marqué (s'il n'est pas partagé
+            // avec un instantané : le retirer du répertoire ne coûte alors qu'une référence)
+            if (lazyDeletion && (*it)->getNbElements() > 0 && it->use_count() == 1) {
+                (*it)->markAllDeleted();
+                ++deadNodes;
+                maybeCompactDirectory();
+                return true;
+            }
+
             nodes.erase(it);
-            delete node;
             return true;
         }
 
@@ -117,102 +424,917 @@ public:
         return std::vector<Element<K, V>*>();  // Retourne une collection vide si aucun nœud trouvé
     }
 
+    // Recherche groupée : results[i] reçoit les éléments de keys[i].
+    // Les clés sont triées puis fusionnées avec le répertoire trié des nœuds en un seul
+    // parcours ; les clés dupliquées ne sont cherchées qu'une fois. Le tampon results
+    // fourni par l'appelant est réutilisé d'un appel à l'autre.
+    void multiGet(const std::vector<K>& keys, std::vector<std::vector<Element<K, V>*>>& results) const {
+        results.resize(keys.size());
+
+        std::vector<size_t> order(keys.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+                  [&keys](size_t a, size_t b) {
+                      return keys[a] < keys[b];
+                  });
+
+        auto it = nodes.begin();
+        size_t previous = keys.size();
+        for (size_t pos : order) {
+            const K& key = keys[pos];
+            std::vector<Element<K, V>*>& out = results[pos];
+            out.clear();
+
+            if (previous != keys.size() && keys[previous] == key) {
+                out.insert(out.end(), results[previous].begin(), results[previous].end());
+                continue;
+            }
+            previous = pos;
+
+            it = seekNode(it, key);
+            if (it != nodes.end() && (*it)->getKey() == key) {
+                (*it)->collectElements(out);
+            }
+        }
+    }
+
     // Ajoute un élément à l'index
     void addElement(Element<K, V>* element) {
         const K& elementKey = element->getKey();
-        Node<K, V>* node = getNode(elementKey);
+        auto it = findLiveNode(elementKey);
 
         // Si aucun nœud n'existe pour cette clé, en créer un
-        if (node == nullptr) {
+        if (it == nodes.end()) {
             addNode(elementKey);
-            node = getNode(elementKey);
+            it = findLiveNode(elementKey);
         }
 
         // Ajouter l'élément au nœud
-        node->addElement(element);
+        mutableNode(it)->addElement(element);
+        ++nbElements;
+        ++version;
+    }
+
+    // Insertion groupée d'un intervalle de paires (clé, valeur)
+    template <typename InputIt>
+    void insertBatch(InputIt first, InputIt last) {
+        std::vector<Element<K, V>*> batch;
+        for (; first != last; ++first) {
+            batch.push_back(new Element<K, V>(first->first, first->second));
+        }
+        insertElements(std::move(batch));
+    }
+
+    template <typename Range>
+    void insertBatch(const Range& pairs) {
+        insertBatch(std::begin(pairs), std::end(pairs));
+    }
+
+    // Insère un lot d'éléments (l'index en prend possession) : le lot est trié puis les
+    // nouvelles clés sont fusionnées au répertoire en un seul passage, et chaque nœud
+    // touché fusionne sa part du lot une seule fois. Coût O(n + b log b).
+    // Un grand lot est trié sur pool.
+    void insertElements(std::vector<Element<K, V>*> batch, ThreadPool& pool = ThreadPool::instance()) {
+        if (batch.empty()) {
+            return;
+        }
+
+        auto elementLess = [](const Element<K, V>* a, const Element<K, V>* b) {
+            return *a < *b;
+        };
+        if (batch.size() >= ParallelSortThreshold) {
+            parallelStableSort(batch.begin(), batch.end(), elementLess, 1 << 15, pool);
+        } else {
+            std::stable_sort(batch.begin(), batch.end(), elementLess);
+        }
+
+        std::vector<NodePtr> merged;
+        merged.reserve(nodes.size() + batch.size());
+
+        auto nodeIt = nodes.begin();
+        auto first = batch.begin();
+        while (first != batch.end()) {
+            const K& key = (*first)->getKey();
+            auto last = std::find_if(first, batch.end(),
+                                     [&key](const Element<K, V>* e) {
+                                         return e->getKey() != key;
+                                     });
+
+            // Recopier les nœuds existants qui précèdent cette clé
+            while (nodeIt != nodes.end() && (*nodeIt)->getKey() < key) {
+                merged.push_back(*nodeIt++);
+            }
+
+            if (nodeIt != nodes.end() && (*nodeIt)->getKey() == key) {
+                if (isRemoved(*nodeIt)) {
+                    --deadNodes;  // Réutilisé : la fusion compacte le nœud
+                }
+                mutableNode(nodeIt)->mergeElements(first, last);
+                merged.push_back(std::move(*nodeIt++));
+            } else {
+                merged.push_back(std::make_shared<Node<K, V>>(key));
+                merged.back()->mergeElements(first, last);
+            }
+
+            first = last;
+        }
+        merged.insert(merged.end(), std::make_move_iterator(nodeIt), std::make_move_iterator(nodes.end()));
+
+        nodes.swap(merged);
+        nbElements += static_cast<int>(batch.size());
+        ++version;
     }
 
     // Supprime un élément de l'index
     bool deleteElement(Element<K, V>* element) {
-        const K& elementKey = element->getKey();
-        Node<K, V>* node = getNode(elementKey);
+        // Copie de la clé : element peut être l'élément stocké, libéré par la suppression
+        const K elementKey = element->getKey();
+        auto it = findLiveNode(elementKey);
+
+        if (it == nodes.end() || !(*it)->containsElement(*element)) {
+            return false;  // Aucun nœud ou aucun élément trouvé pour cette clé
+        }
+
+        Node<K, V>* node = mutableNode(it);
+        bool deleted = lazyDeletion ? node->markDeleted(element) : node->deleteElement(element);
+        if (!deleted) {
+            return false;
+        }
+        --nbElements;
+        ++version;
+
+        if (node->getNbElements() == 0) {
+            // Si le nœud est vide après suppression, le supprimer aussi
+            if (lazyDeletion) {
+                ++deadNodes;
+                maybeCompactDirectory();
+            } else {
+                deleteNode(elementKey);
+            }
+        } else if (node->getNbDeleted() > compactionThreshold * (node->getNbElements() + node->getNbDeleted())) {
+            node->compact();  // Compactage incrémental, nœud par nœud
+        }
+
+        return true;
+    }
+
+    // Active ou désactive la suppression paresseuse : les suppressions marquent les éléments
+    // au lieu de décaler les tableaux. threshold est la proportion de supprimés au-delà de
+    // laquelle un nœud (ou le répertoire) est compacté.
+    void setLazyDeletion(bool enabled, double threshold = 0.25) {
+        lazyDeletion = enabled;
+        compactionThreshold = threshold;
+        if (!enabled) {
+            compact();
+        }
+    }
+
+    bool isLazyDeletion() const { return lazyDeletion; }
+
+    // Nombre d'éléments marqués supprimés en attente de compactage
+    int getNbDeleted() const {
+        int count = 0;
+        for (const auto& node : nodes) {
+            count += node->getNbDeleted();
+        }
+        return count;
+    }
+
+    // Compacte immédiatement le répertoire et tous les nœuds
+    void compact() {
+        compactDirectory();
+        for (auto it = nodes.begin(); it != nodes.end(); ++it) {
+            if ((*it)->getNbDeleted() > 0) {
+                mutableNode(it)->compact();
+            }
+        }
+    }
+
+    // Retourne les éléments dont la clé est dans [lo, hi] (bornes incluses), par clé puis valeur
+    std::vector<Element<K, V>*> getRange(const K& lo, const K& hi) const {
+        std::vector<Element<K, V>*> result;
+        if (hi < lo) {
+            return result;
+        }
+        for (auto it = seekNode(nodes.begin(), lo); it != nodes.end() && !(hi < (*it)->getKey()); ++it) {
+            (*it)->collectElements(result);
+        }
+        return result;
+    }
+
+    // Position de fin de parcours retournée par scanRange
+    static constexpr size_t ScanEnd = static_cast<size_t>(-1);
+
+    // Parcours de [lo, hi] par morceaux : ajoute à out les éléments d'au plus maxNodes nœuds
+    // à partir de position (0 au premier appel) et retourne la position de reprise, ou ScanEnd
+    // une fois l'intervalle épuisé. Les positions ne restent valides que si l'index n'est pas
+    // modifié entre deux appels (parcourir un instantané).
+    size_t scanRange(const K& lo, const K& hi, size_t position, size_t maxNodes,
+                     std::vector<Element<K, V>*>& out) const {
+        if (hi < lo || position >= nodes.size()) {
+            return ScanEnd;
+        }
+        maxNodes = std::max<size_t>(1, maxNodes);
+        NodeIterator it = position == 0 ? seekNode(nodes.begin(), lo) : nodes.begin() + position;
+        for (size_t visited = 0; it != nodes.end() && !(hi < (*it)->getKey()); ++it, ++visited) {
+            if (visited == maxNodes) {
+                return static_cast<size_t>(it - nodes.begin());
+            }
+            (*it)->collectElements(out);
+        }
+        return ScanEnd;
+    }
+
+    // Parcours de tout l'index par pages : ajoute à out au plus maxElements éléments à partir
+    // de cursor, dans l'ordre de l'index, et avance cursor (done une fois l'index épuisé).
+    // Comme pour scanRange, le curseur ne reste valide que si l'index n'est pas modifié.
+    void collectPage(PageCursor& cursor, size_t maxElements, std::vector<Element<K, V>*>& out) const {
+        while (maxElements > 0 && cursor.node < nodes.size()) {
+            const NodePtr& node = nodes[cursor.node];
+            size_t before = out.size();
+            cursor.slot = isRemoved(node) ? node->getNbSlots()
+                                          : node->collectElements(cursor.slot, maxElements, out);
+            maxElements -= out.size() - before;
+            if (cursor.slot >= node->getNbSlots()) {
+                ++cursor.node;
+                cursor.slot = 0;
+            }
+        }
+        cursor.done = cursor.node >= nodes.size();
+    }
+
+    // Compte les éléments de clé dans [lo, hi] (bornes incluses), sans les collecter
+    int countRange(const K& lo, const K& hi) const {
+        int count = 0;
+        if (hi < lo) {
+            return count;
+        }
+        for (auto it = seekNode(nodes.begin(), lo); it != nodes.end() && !(hi < (*it)->getKey()); ++it) {
+            count += (*it)->getNbElements();
+        }
+        return count;
+    }
+
+    // Appelle f(const Node<K, V>&) pour chaque nœud, dans l'ordre des clés
+    template <typename F>
+    void forEachNode(F f) const {
+        for (const auto& node : nodes) {
+            if (!isRemoved(node)) {
+                f(*node);
+            }
+        }
+    }
+
+    // Supprime tous les éléments dont la clé est dans [lo, hi] (bornes incluses).
+    // Retourne le nombre d'éléments supprimés.
+    int deleteRange(const K& lo, const K& hi) {
+        if (hi < lo) {
+            return 0;
+        }
+
+        auto first = seekNode(nodes.begin(), lo);
+        auto last = std::upper_bound(first, NodeIterator(nodes.end()), hi,
+                                     [](const K& k, const NodePtr& node) {
+                                         return k < node->getKey();
+                                     });
+
+        int removed = 0;
+        for (auto it = first; it != last; ++it) {
+            if (isRemoved(*it)) {
+                --deadNodes;
+            }
+            removed += (*it)->getNbElements();
+        }
+        nodes.erase(first, last);
+        nbElements -= removed;
+        ++version;
+        return removed;
+    }
+
+    // Supprime les éléments de clé key pour lesquels pred est vrai.
+    // Le nœud est supprimé s'il devient vide. Retourne le nombre d'éléments supprimés.
+    template <typename Predicate>
+    int deleteWhere(const K& key, Predicate pred) {
+        auto it = findLiveNode(key);
+        if (it == nodes.end() || !(*it)->anyElement(pred)) {
+            return 0;
+        }
+
+        Node<K, V>* node = mutableNode(it);
+        int removed = node->removeIf(pred);
+        nbElements -= removed;
+        ++version;
+        if (removed > 0 && node->getNbElements() == 0) {
+            deleteNode(key);
+        }
+        return removed;
+    }
 
-        if (node == nullptr) {
-            return false;  // Aucun nœud trouvé pour cette clé
+    // Supprime tous les éléments pour lesquels pred est vrai, en compactant les nœuds
+    // et le répertoire dans le même passage. Retourne le nombre d'éléments supprimés.
+    template <typename Predicate>
+    int deleteWhere(Predicate pred) {
+        int removed = 0;
+        auto kept = nodes.begin();
+        for (auto it = nodes.begin(); it != nodes.end(); ++it) {
+            bool wasRemoved = isRemoved(*it);
+            int removedHere = 0;
+            // Les nœuds sans élément concerné ne sont pas touchés (ni copiés s'ils sont partagés)
+            if (wasRemoved || (*it)->anyElement(pred)) {
+                removedHere = mutableNode(it)->removeIf(pred);
+            }
+            removed += removedHere;
+
+            // Un nœud vidé par ce passage est supprimé, comme dans deleteElement
+            if ((removedHere > 0 || wasRemoved) && (*it)->getNbElements() == 0) {
+                continue;
+            }
+            if (kept != it) {
+                *kept = std::move(*it);
+            }
+            ++kept;
         }
+        nodes.erase(kept, nodes.end());
+        deadNodes = 0;
+        nbElements -= removed;
+        ++version;
+        return removed;
+    }
 
-        bool deleted = node->deleteElement(element);
+    // Analyse une ligne "clé ; valeur" du format des fichiers d'index.
+    // Retourne false pour une ligne vide ou invalide (avec un avertissement sur std::cerr).
+    static bool parseLine(const std::string& line, K& key, V& value) {
+        // Ignorer les lignes vides
+        if (line.empty()) {
+            return false;
+        }
 
-        // Si le nœud est vide après suppression, le supprimer aussi
-        if (deleted && node->getNbElements() == 0) {
-            deleteNode(elementKey);
+        // Trouver le séparateur ';'
+        size_t separatorPos = line.find(';');
+        if (separatorPos == std::string::npos) {
+            std::cerr << "Avertissement: Ligne mal formatée ignorée: " << line << std::endl;
+            return false;
         }
 
-        return deleted;
+        // Délimiter la clé et la valeur, sans les espaces en début et fin (ni copie)
+        const char* keyFirst = line.data();
+        const char* keyLast = keyFirst + separatorPos;
+        const char* valueFirst = keyLast + 1;
+        const char* valueLast = line.data() + line.size();
+        trimField(keyFirst, keyLast);
+        trimField(valueFirst, valueLast);
+
+        try {
+            // Convertir la clé et la valeur aux types K et V
+            convertField(keyFirst, keyLast, key);
+            convertField(valueFirst, valueLast, value);
+            return true;
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Erreur lors de la conversion: " << e.what()
+                      << " pour la ligne: " << line << std::endl;
+            return false;
+        }
     }
 
-    // Charge un index depuis un fichier existant
-    bool loadFromFile(const std::string& filename) {
+    // Analyse les lignes d'un fichier d'index et passe chaque paire valide à add(key, value),
+    // dans l'ordre du fichier. progress, s'il est fourni, est tenu à jour pendant la lecture.
+    // Retourne false si le fichier ne peut pas être ouvert ou si la lecture est annulée.
+    template <typename Add>
+    static bool readLines(const std::string& filename, LoadProgress* progress, Add add) {
         std::ifstream file(filename);
         if (!file.is_open()) {
             std::cerr << "Erreur: Impossible d'ouvrir le fichier " << filename << std::endl;
             return false;
         }
 
-        // Nettoyer l'index existant
-        for (auto node : nodes) {
-            delete node;
+        if (progress != nullptr) {
+            file.seekg(0, std::ios::end);
+            progress->totalBytes = static_cast<size_t>(file.tellg());
+            file.seekg(0, std::ios::beg);
         }
-        nodes.clear();
 
         std::string line;
+        K key;
+        V value;
+        size_t lines = 0, bytes = 0, errors = 0;
         while (std::getline(file, line)) {
-            // Ignorer les lignes vides
-            if (line.empty()) {
+            ++lines;
+            bytes += line.size() + 1;
+            if (parseLine(line, key, value)) {
+                add(key, value);
+            } else if (!line.empty()) {
+                ++errors;
+            }
+
+            // Publier l'avancement par paquets de lignes
+            if (progress != nullptr && (lines % 4096 == 0 || file.peek() == EOF)) {
+                progress->lines = lines;
+                progress->bytesRead = std::min(bytes, progress->totalBytes.load());
+                progress->errors = errors;
+                if (progress->cancelled) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Lit les éléments d'un fichier d'index, dans l'ordre du fichier, à la fin de out.
+    // progress, s'il est fourni, est tenu à jour pendant la lecture. Retourne false si le
+    // fichier ne peut pas être ouvert ou si la lecture est annulée (out est alors inchangé).
+    static bool readElements(const std::string& filename, std::vector<Element<K, V>*>& out,
+                             LoadProgress* progress = nullptr) {
+        const size_t first = out.size();
+        bool read = readLines(filename, progress, [&out](const K& key, const V& value) {
+            out.push_back(new Element<K, V>(key, value));
+        });
+        if (!read) {
+            for (size_t i = first; i < out.size(); ++i) {
+                delete out[i];
+            }
+            out.resize(first);
+        }
+        return read;
+    }
+
+    // Charge un index depuis un fichier existant. L'index n'est remplacé qu'une fois le
+    // fichier entièrement lu : en cas d'échec ou d'annulation, il reste inchangé.
+    // progress, s'il est fourni, est tenu à jour pendant la lecture.
+    // Tant que les lignes arrivent triées par clé puis valeur, les nœuds sont construits à la
+    // volée, à la fin du répertoire, sans recherche ni tri. À la première ligne hors d'ordre,
+    // la suite du fichier est lue en un lot, trié sur pool puis fusionné à ces nœuds (insertElements).
+    bool loadFromFile(const std::string& filename, LoadProgress* progress = nullptr,
+                      ThreadPool& pool = ThreadPool::instance()) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<NodePtr> loaded;            // Nœuds de la partie triée du fichier
+        std::vector<Element<K, V>*> group;      // Éléments de la clé en cours (partie triée)
+        std::vector<Element<K, V>*> rest;       // Éléments qui suivent la première ligne hors d'ordre
+        int sortedCount = 0;
+
+        auto flushGroup = [&]() {
+            if (!group.empty()) {
+                loaded.push_back(std::make_shared<Node<K, V>>(group.front()->getKey()));
+                loaded.back()->mergeElements(group.begin(), group.end());   // Nœud vide : simple copie
+                sortedCount += static_cast<int>(group.size());
+                group.clear();
+            }
+        };
+        bool read = readLines(filename, progress, [&](const K& key, const V& value) {
+            if (!rest.empty()) {
+                rest.push_back(new Element<K, V>(key, value));
+                return;
+            }
+            if (!group.empty()) {
+                const Element<K, V>* last = group.back();
+                if (key < last->getKey() || (key == last->getKey() && value < last->getValue())) {
+                    flushGroup();
+                    rest.push_back(new Element<K, V>(key, value));
+                    return;
+                }
+                if (last->getKey() < key) {
+                    flushGroup();
+                }
+            }
+            group.push_back(new Element<K, V>(key, value));
+        });
+        if (!read) {
+            for (auto* element : group) {
+                delete element;
+            }
+            for (auto* element : rest) {
+                delete element;
+            }
+            return false;
+        }
+        flushGroup();
+
+        // Remplacer l'index existant par la partie triée, puis y fusionner le reste
+        nodes.swap(loaded);
+        loaded.clear();   // Ancien contenu libéré avant la fusion
+        ++version;
+        deadNodes = 0;
+        nbElements = sortedCount;
+        insertElements(std::move(rest), pool);
+
+        loadTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return true;
+    }
+
+    // Remplace le contenu de l'index par la fusion de suites d'éléments, chacune triée par
+    // clé puis valeur (par exemple un fichier chacune) ; l'index prend possession des
+    // éléments et runs est vidé. La fusion k-voies est découpée en intervalles de clés,
+    // fusionnés en parallèle : un nœud n'est construit que par une seule tâche.
+    void mergeSortedRuns(std::vector<std::vector<Element<K, V>*>>& runs, ThreadPool& pool = ThreadPool::instance()) {
+        auto start = std::chrono::steady_clock::now();
+        auto keyLess = [](const Element<K, V>* element, const K& key) {
+            return element->getKey() < key;
+        };
+
+        // Clés de découpage : quantiles d'un échantillon régulier de chaque suite
+        size_t total = 0;
+        for (const auto& run : runs) {
+            total += run.size();
+        }
+        const size_t parts = std::max<size_t>(1, std::min(pool.size() * 4, total / 4096));
+        std::vector<K> samples;
+        for (const auto& run : runs) {
+            for (size_t i = 1; i < parts && !run.empty(); ++i) {
+                samples.push_back(run[i * run.size() / parts]->getKey());
+            }
+        }
+        std::sort(samples.begin(), samples.end());
+        std::vector<K> splitters;
+        for (size_t i = 1; i < parts && !samples.empty(); ++i) {
+            const K& key = samples[i * samples.size() / parts];
+            if (splitters.empty() || splitters.back() < key) {
+                splitters.push_back(key);
+            }
+        }
+
+        // Intervalle p : clés de [splitters[p - 1], splitters[p])
+        std::vector<std::vector<NodePtr>> built(splitters.size() + 1);
+        parallelFor(0, built.size(), 1, [&](size_t lo, size_t hi) {
+            using Cursor = std::pair<typename std::vector<Element<K, V>*>::const_iterator,
+                                     typename std::vector<Element<K, V>*>::const_iterator>;
+            std::vector<Element<K, V>*> merged, group;
+            for (size_t part = lo; part < hi; ++part) {
+                std::vector<Cursor> cursors;
+                size_t size = 0;
+                for (const auto& run : runs) {
+                    auto first = part == 0 ? run.begin()
+                                           : std::lower_bound(run.begin(), run.end(), splitters[part - 1], keyLess);
+                    auto last = part == splitters.size() ? run.end()
+                                                         : std::lower_bound(first, run.end(), splitters[part], keyLess);
+                    if (first != last) {
+                        cursors.emplace_back(first, last);
+                        size += static_cast<size_t>(last - first);
+                    }
+                }
+
+                // Fusion k-voies par un tas des têtes de suites
+                auto headGreater = [](const Cursor& a, const Cursor& b) {
+                    return **b.first < **a.first;
+                };
+                merged.clear();
+                merged.reserve(size);
+                std::make_heap(cursors.begin(), cursors.end(), headGreater);
+                while (!cursors.empty()) {
+                    std::pop_heap(cursors.begin(), cursors.end(), headGreater);
+                    Cursor& cursor = cursors.back();
+                    merged.push_back(*cursor.first++);
+                    if (cursor.first == cursor.second) {
+                        cursors.pop_back();
+                    } else {
+                        std::push_heap(cursors.begin(), cursors.end(), headGreater);
+                    }
+                }
+
+                for (auto first = merged.begin(); first != merged.end();) {
+                    const K& key = (*first)->getKey();
+                    auto last = std::find_if(first, merged.end(), [&key](const Element<K, V>* e) {
+                        return e->getKey() != key;
+                    });
+                    built[part].push_back(std::make_shared<Node<K, V>>(key));
+                    built[part].back()->mergeElements(first, last);
+                    first = last;
+                }
+            }
+        }, pool);
+
+        std::vector<NodePtr> directory;
+        directory.reserve(std::accumulate(built.begin(), built.end(), size_t(0),
+                                          [](size_t sum, const std::vector<NodePtr>& part) { return sum + part.size(); }));
+        for (auto& part : built) {
+            std::move(part.begin(), part.end(), std::back_inserter(directory));
+        }
+        runs.clear();
+
+        nodes.swap(directory);
+        ++version;
+        deadNodes = 0;
+        nbElements = static_cast<int>(total);
+        loadTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Lit les paires d'un fichier d'index, triées par clé puis valeur
+    static bool readPairs(const std::string& filename, std::vector<std::pair<K, V>>& pairs) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Erreur: Impossible d'ouvrir le fichier " << filename << std::endl;
+            return false;
+        }
+        std::string line;
+        K key;
+        V value;
+        while (std::getline(file, line)) {
+            if (parseLine(line, key, value)) {
+                pairs.emplace_back(key, value);
+            }
+        }
+        if (!std::is_sorted(pairs.begin(), pairs.end())) {   // Fichier exporté : déjà trié
+            std::sort(pairs.begin(), pairs.end());
+        }
+        return true;
+    }
+
+    // Remplace le contenu de l'index par pairs (triées par clé puis valeur) en n'appliquant
+    // que la différence : une fusion triée sur (clé, valeur) avec les éléments actuels donne
+    // les ajouts et les suppressions. Les nœuds inchangés sont conservés tels quels (sans
+    // copie s'ils sont partagés) ; les éléments en double sont comptés comme un multiensemble.
+    void applyDifference(const std::vector<std::pair<K, V>>& pairs, ReloadSummary<K>* summary = nullptr) {
+        ReloadSummary<K> local;
+        ReloadSummary<K>& changes = summary != nullptr ? *summary : local;
+        changes = ReloadSummary<K>();
+
+        std::vector<NodePtr> merged;
+        merged.reserve(nodes.size());
+        std::vector<Element<K, V>*> current, additions;
+        std::vector<V> removals;
+        auto nodeIt = nodes.begin();
+        auto first = pairs.begin();
+        while (nodeIt != nodes.end() || first != pairs.end()) {
+            if (nodeIt != nodes.end() && isRemoved(*nodeIt)) {
+                ++nodeIt;
                 continue;
             }
 
-            // Trouver le séparateur ';'
-            size_t separatorPos = line.find(';');
-            if (separatorPos == std::string::npos) {
-                std::cerr << "Avertissement: Ligne mal formatée ignorée: " << line << std::endl;
+            // Clé disparue du fichier : nœud retiré
+            if (first == pairs.end() || (nodeIt != nodes.end() && (*nodeIt)->getKey() < first->first)) {
+                changes.removed += (*nodeIt)->getNbElements();
+                ++changes.nodesRemoved;
+                changes.changedKeys.push_back((*nodeIt)->getKey());
+                ++nodeIt;
                 continue;
             }
 
-            // Extraire la clé et la valeur
-            std::string keyStr = line.substr(0, separatorPos);
-            std::string valueStr = line.substr(separatorPos + 1);
+            const K& key = first->first;
+            auto last = std::find_if(first, pairs.end(), [&key](const std::pair<K, V>& pair) {
+                return pair.first != key;
+            });
+
+            // Nouvelle clé : nœud créé
+            if (nodeIt == nodes.end() || key < (*nodeIt)->getKey()) {
+                additions.clear();
+                for (auto it = first; it != last; ++it) {
+                    additions.push_back(new Element<K, V>(it->first, it->second));
+                }
+                merged.push_back(std::make_shared<Node<K, V>>(key));
+                merged.back()->mergeElements(additions.begin(), additions.end());
+                changes.added += static_cast<int>(additions.size());
+                ++changes.nodesAdded;
+                changes.changedKeys.push_back(key);
+                first = last;
+                continue;
+            }
+
+            // Clé présente des deux côtés : fusion des valeurs triées
+            current.clear();
+            (*nodeIt)->collectElements(current);
+            additions.clear();
+            removals.clear();
+            auto element = current.begin();
+            for (auto it = first; it != last || element != current.end();) {
+                if (it == last || (element != current.end() && (*element)->getValue() < it->second)) {
+                    removals.push_back((*element++)->getValue());
+                } else if (element == current.end() || it->second < (*element)->getValue()) {
+                    additions.push_back(new Element<K, V>(it->first, it->second));
+                    ++it;
+                } else {
+                    ++changes.unchanged;
+                    ++element;
+                    ++it;
+                }
+            }
+
+            if (!removals.empty() || !additions.empty()) {
+                Node<K, V>* node = mutableNode(nodeIt);
+                // removeIf parcourt les éléments par valeur croissante, comme removals
+                size_t next = 0;
+                node->removeIf([&](const Element<K, V>& candidate) {
+                    while (next < removals.size() && removals[next] < candidate.getValue()) {
+                        ++next;
+                    }
+                    if (next < removals.size() && !(candidate.getValue() < removals[next])) {
+                        ++next;
+                        return true;
+                    }
+                    return false;
+                });
+                node->mergeElements(additions.begin(), additions.end());
+                changes.added += static_cast<int>(additions.size());
+                changes.removed += static_cast<int>(removals.size());
+                changes.changedKeys.push_back(key);
+            }
+            merged.push_back(std::move(*nodeIt++));
+            first = last;
+        }
 
-            // Supprimer les espaces en début et fin
-            keyStr.erase(0, keyStr.find_first_not_of(" \t"));
-            keyStr.erase(keyStr.find_last_not_of(" \t") + 1);
-            valueStr.erase(0, valueStr.find_first_not_of(" \t"));
-            valueStr.erase(valueStr.find_last_not_of(" \t") + 1);
+        nodes.swap(merged);
+        deadNodes = 0;
+        if (!changes.empty()) {
+            nbElements += changes.added - changes.removed;
+            ++version;
+        }
+    }
 
-            try {
-                // Convertir la clé et la valeur aux types K et V
-                K key = convertFromString<K>(keyStr);
-                V value = convertFromString<V>(valueStr);
+    // Relit filename et n'applique que ses différences avec le contenu actuel (voir
+    // applyDifference), au lieu de reconstruire l'index comme loadFromFile. summary, s'il
+    // est fourni, reçoit les changements. L'index reste inchangé si le fichier est illisible.
+    bool reloadFromFile(const std::string& filename, ReloadSummary<K>* summary = nullptr) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::pair<K, V>> pairs;
+        if (!readPairs(filename, pairs)) {
+            return false;
+        }
+        applyDifference(pairs, summary);
+        loadTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return true;
+    }
 
-                // Créer et ajouter l'élément à l'index
-                Element<K, V>* element = new Element<K, V>(key, value);
-                addElement(element);
+    // Enregistre l'index au format texte "clé ; valeur" relu par loadFromFile, un élément par
+    // ligne dans l'ordre de l'index. Les nœuds sont formatés en parallèle par tranches dans
+    // des tampons, écrits dans l'ordre dans filename.tmp puis renommé : filename n'est jamais
+    // visible à moitié écrit. Ne se relisent pas à l'identique : les valeurs contenant un
+    // saut de ligne ou commençant/finissant par un espace, et les clés contenant ';'.
+    bool saveToFile(const std::string& filename, ThreadPool& pool = ThreadPool::instance()) const {
+        const std::string temporary = filename + ".tmp";
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Erreur: Impossible de créer le fichier " << temporary << std::endl;
+            return false;
+        }
+
+        // Tranches de nœuds consécutifs d'environ ChunkElements éléments
+        const size_t ChunkElements = 1 << 15;
+        std::vector<size_t> bounds{0};
+        size_t pending = 0;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (!isRemoved(nodes[i])) {
+                pending += nodes[i]->getNbSlots();
             }
-            catch (const std::exception& e) {
-                std::cerr << "Erreur lors de la conversion: " << e.what()
-                          << " pour la ligne: " << line << std::endl;
+            if (pending >= ChunkElements) {
+                bounds.push_back(i + 1);
+                pending = 0;
+            }
+        }
+        if (bounds.back() != nodes.size()) {
+            bounds.push_back(nodes.size());
+        }
+
+        // Fenêtres de quelques tranches par thread : la mémoire formatée reste bornée
+        const size_t nbChunks = bounds.size() - 1;
+        const size_t window = pool.size() * 4;
+        std::vector<std::string> chunks;
+        for (size_t first = 0; first < nbChunks && file; first += window) {
+            chunks.assign(std::min(window, nbChunks - first), std::string());
+            parallelFor(0, chunks.size(), 1, [&](size_t lo, size_t hi) {
+                std::vector<Element<K, V>*> elements;
+                for (size_t chunk = lo; chunk < hi; ++chunk) {
+                    std::string& text = chunks[chunk];
+                    for (size_t i = bounds[first + chunk]; i < bounds[first + chunk + 1]; ++i) {
+                        if (isRemoved(nodes[i])) continue;
+                        elements.clear();
+                        nodes[i]->collectElements(elements);
+                        for (const auto* element : elements) {
+                            appendText(text, element->getKey());
+                            text += " ; ";
+                            appendText(text, element->getValue());
+                            text += '\n';
+                        }
+                    }
+                }
+            }, pool);
+            for (const auto& chunk : chunks) {
+                file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
             }
         }
 
         file.close();
+        if (!file) {
+            std::cerr << "Erreur: Écriture incomplète du fichier " << temporary << std::endl;
+            std::remove(temporary.c_str());
+            return false;
+        }
+        if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+            std::cerr << "Erreur: Impossible de remplacer le fichier " << filename << std::endl;
+            std::remove(temporary.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Enregistre l'index dans un instantané binaire (format : voir Serialization.h), relu
+    // bien plus vite qu'un fichier texte par loadSnapshot.
+    bool saveSnapshot(const std::string& filename) const {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Erreur: Impossible de créer le fichier " << filename << std::endl;
+            return false;
+        }
+
+        writeSnapshotHeader<K, V>(file, static_cast<uint64_t>(getNbNodes()));
+        std::vector<Element<K, V>*> elements;
+        for (const auto& node : nodes) {
+            if (isRemoved(node)) continue;
+            elements.clear();
+            node->collectElements(elements);
+            writeBinary(file, node->getKey());
+            writeBinary(file, static_cast<uint64_t>(elements.size()));
+            for (const auto* element : elements) {
+                writeBinary(file, element->getValue());
+            }
+        }
+
+        if (!file.flush()) {
+            std::cerr << "Erreur: Écriture incomplète du fichier " << filename << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // Recharge un instantané écrit par saveSnapshot. L'index n'est remplacé qu'une fois
+    // le fichier entièrement lu ; un fichier d'un autre type d'index est refusé.
+    // Le fichier est lu nœud par nœud, mais l'index obtenu tient tout en mémoire : pour un
+    // instantané plus grand que la mémoire, voir SpillingIndex::loadSnapshot.
+    // progress, s'il est fourni, compte les éléments lus (lines) et permet l'annulation.
+    bool loadSnapshot(const std::string& filename, LoadProgress* progress = nullptr) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Erreur: Impossible d'ouvrir le fichier " << filename << std::endl;
+            return false;
+        }
+        if (progress != nullptr) {
+            file.seekg(0, std::ios::end);
+            progress->totalBytes = static_cast<size_t>(file.tellg());
+            file.seekg(0, std::ios::beg);
+        }
+        auto start = std::chrono::steady_clock::now();
+
+        uint64_t nbNodes;
+        if (!readSnapshotHeader<K, V>(file, nbNodes)) {
+            std::cerr << "Erreur: " << filename << " n'est pas un instantané de ce type d'index" << std::endl;
+            return false;
+        }
+
+        // Un nombre de nœuds que la taille du fichier ne permet pas est refusé avant
+        // d'allouer le répertoire
+        if (!snapshotNodesFit<K>(file, nbNodes)) {
+            std::cerr << "Erreur: Instantané tronqué ou corrompu " << filename << std::endl;
+            return false;
+        }
+
+        std::vector<NodePtr> loaded;
+        loaded.reserve(nbNodes);
+        std::vector<Element<K, V>*> elements;
+        int count = 0;
+        K key;
+        V value;
+        uint64_t size;
+        for (uint64_t i = 0; i < nbNodes; ++i) {
+            if (progress != nullptr && i % 4096 == 0) {
+                progress->lines = static_cast<size_t>(count);
+                progress->bytesRead = static_cast<size_t>(file.tellg());
+                if (progress->cancelled) {
+                    return false;
+                }
+            }
+            if (!readBinary(file, key) || !readBinary(file, size)) {
+                std::cerr << "Erreur: Instantané tronqué " << filename << std::endl;
+                return false;
+            }
+            elements.clear();
+            for (uint64_t j = 0; j < size && readBinary(file, value); ++j) {
+                elements.push_back(new Element<K, V>(key, value));
+            }
+            // Le nœud prend possession des éléments lus, même incomplets
+            loaded.push_back(std::make_shared<Node<K, V>>(key));
+            loaded.back()->mergeElements(elements.begin(), elements.end());
+            if (elements.size() != size) {
+                std::cerr << "Erreur: Instantané tronqué " << filename << std::endl;
+                return false;
+            }
+            count += static_cast<int>(size);
+        }
+        if (progress != nullptr) {
+            progress->lines = static_cast<size_t>(count);
+            progress->bytesRead = progress->totalBytes.load();
+        }
+
+        nodes.swap(loaded);
+        ++version;
+        deadNodes = 0;
+        nbElements = count;
+        loadTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
         return true;
     }
 
     // Affiche l'index (pour débogage)
     friend std::ostream& operator<<(std::ostream& os, const Index<K, V>& index) {
-        os << "Index{" << std::endl;
+        os << "Index{\n";
         for (const auto& node : index.nodes) {
-            os << "  " << *node << std::endl;
+            if (isRemoved(node)) continue;
+            os << "  " << *node << '\n';
         }
         os << "}";
         return os;
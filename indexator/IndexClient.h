@@ -0,0 +1,336 @@
+#ifndef INDEX_CLIENT_H
+#define INDEX_CLIENT_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "Protocol.h"
+
+// Réponse du serveur à une requête
+struct Response {
+    ResponseStatus status = ResponseStatus::ERROR;
+    uint32_t id = 0;          // Identifiant de la requête
+    std::string body;
+
+    FrameReader reader() const {
+        return FrameReader(body.data(), body.size());
+    }
+};
+
+// Statistiques d'un index distant (réponse à STATS)
+struct RemoteStats {
+    uint8_t keyTag = 0;       // Types de clé et de valeur (voir BinaryTag)
+    uint8_t valueTag = 0;
+    uint32_t nbNodes = 0;
+    uint32_t nbElements = 0;
+    uint64_t bytes = 0;
+};
+
+// Client bloquant du serveur d'index (voir IndexServer et Protocol.h).
+// Les méthodes get, range... envoient une requête et attendent sa réponse. Pour enchaîner
+// des requêtes sans attendre (pipelining) : request() plusieurs fois, flush(), puis
+// receive() une fois par requête, les réponses arrivant dans l'ordre.
+// Les clés et valeurs doivent avoir les types de l'index interrogé.
+class IndexClient {
+public:
+    IndexClient() {}
+
+    ~IndexClient() {
+        disconnect();
+    }
+
+    IndexClient(const IndexClient&) = delete;
+    IndexClient& operator=(const IndexClient&) = delete;
+
+    bool connectUnix(const std::string& path) {
+        disconnect();
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path)) {
+            lastError = "Chemin de socket trop long";
+            return false;
+        }
+        address.sun_family = AF_UNIX;
+        std::strcpy(address.sun_path, path.c_str());
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        return connectTo(reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    }
+
+    bool connectTcp(uint16_t port, const std::string& host = "127.0.0.1") {
+        disconnect();
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+            lastError = "Adresse invalide: " + host;
+            return false;
+        }
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (!connectTo(reinterpret_cast<sockaddr*>(&address), sizeof(address))) {
+            return false;
+        }
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        return true;
+    }
+
+    void disconnect() {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+        output.clear();
+        input.clear();
+        inputOffset = 0;
+    }
+
+    bool isConnected() const {
+        return fd >= 0;
+    }
+
+    // Dernière erreur de connexion, d'envoi ou message d'erreur du serveur
+    const std::string& getLastError() const {
+        return lastError;
+    }
+
+    // Met en file une requête (envoyée par flush) et retourne son identifiant.
+    // Les arguments sont des clés, des valeurs ou des vecteurs (préfixés par leur taille).
+    template <typename... Args>
+    uint32_t request(Opcode opcode, const std::string& index, const Args&... args) {
+        FrameWriter frame(output);
+        frame.begin();
+        frame.put(static_cast<uint8_t>(opcode));
+        frame.put(nextId);
+        frame.put(index);
+        (putArgument(frame, args), ...);
+        frame.end();
+        return nextId++;
+    }
+
+    // Envoie les requêtes en file
+    bool flush() {
+        size_t offset = 0;
+        while (offset < output.size()) {
+            ssize_t sent = send(fd, output.data() + offset, output.size() - offset, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return fail(std::string("Envoi impossible: ") + std::strerror(errno));
+            }
+            offset += static_cast<size_t>(sent);
+        }
+        output.clear();
+        return true;
+    }
+
+    // Attend la réponse suivante
+    bool receive(Response& response) {
+        while (input.size() - inputOffset < FrameHeaderSize
+               || input.size() - inputOffset - FrameHeaderSize < frameSize(input.data() + inputOffset)) {
+            if (inputOffset > 0) {
+                input.erase(0, inputOffset);
+                inputOffset = 0;
+            }
+            char buffer[65536];
+            ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received <= 0) {
+                return fail("Connexion fermée par le serveur");
+            }
+            input.append(buffer, static_cast<size_t>(received));
+        }
+
+        uint32_t size = frameSize(input.data() + inputOffset);
+        FrameReader frame(input.data() + inputOffset + FrameHeaderSize, size);
+        uint8_t status = 0;
+        if (!frame.get(status) || !frame.get(response.id)) {
+            return fail("Réponse mal formée");
+        }
+        response.status = static_cast<ResponseStatus>(status);
+        const size_t headerSize = sizeof(uint8_t) + sizeof(uint32_t);
+        response.body.assign(input.data() + inputOffset + FrameHeaderSize + headerSize, size - headerSize);
+        inputOffset += FrameHeaderSize + size;
+        return true;
+    }
+
+    // Envoie une requête et attend sa réponse ; retourne son statut (ERROR si la connexion
+    // a échoué, voir getLastError)
+    template <typename... Args>
+    ResponseStatus call(Response& response, Opcode opcode, const std::string& index, const Args&... args) {
+        request(opcode, index, args...);
+        if (!flush() || !receive(response)) {
+            response.status = ResponseStatus::ERROR;
+            return response.status;
+        }
+        if (response.status == ResponseStatus::ERROR) {
+            FrameReader reader = response.reader();
+            reader.get(lastError);
+        }
+        return response.status;
+    }
+
+    template <typename K, typename V>
+    bool get(const std::string& index, const K& key, std::vector<V>& values) {
+        Response response;
+        if (call(response, Opcode::GET, index, key) != ResponseStatus::OK) {
+            return false;
+        }
+        FrameReader reader = response.reader();
+        return readValues(reader, values) || fail("Réponse mal formée");
+    }
+
+    template <typename K, typename V>
+    bool multiGet(const std::string& index, const std::vector<K>& keys, std::vector<std::vector<V>>& values) {
+        Response response;
+        if (call(response, Opcode::MULTI_GET, index, keys) != ResponseStatus::OK) {
+            return false;
+        }
+        FrameReader reader = response.reader();
+        values.assign(keys.size(), {});
+        for (auto& keyValues : values) {
+            if (!readValues(reader, keyValues)) {
+                return fail("Réponse mal formée");
+            }
+        }
+        return true;
+    }
+
+    // Paires de [lo, hi] ; une réponse tronquée (PARTIAL) est suivie d'une nouvelle requête
+    // à partir de la clé où reprendre, jusqu'à la fin de l'intervalle
+    template <typename K, typename V>
+    bool range(const std::string& index, const K& lo, const K& hi, std::vector<std::pair<K, V>>& pairs) {
+        pairs.clear();
+        K from = lo;
+        while (true) {
+            Response response;
+            ResponseStatus status = call(response, Opcode::RANGE, index, from, hi);
+            if (status != ResponseStatus::OK && status != ResponseStatus::PARTIAL) {
+                return false;
+            }
+            FrameReader reader = response.reader();
+            uint32_t size;
+            if (!reader.get(size)) {
+                return fail("Réponse mal formée");
+            }
+            size_t first = pairs.size();
+            pairs.resize(first + size);
+            for (size_t i = first; i < pairs.size(); ++i) {
+                if (!reader.get(pairs[i].first) || !reader.get(pairs[i].second)) {
+                    return fail("Réponse mal formée");
+                }
+            }
+            if (status == ResponseStatus::OK) {
+                return true;
+            }
+            K next;
+            if (!reader.get(next) || !(from < next)) {
+                return fail("Réponse mal formée");
+            }
+            from = next;
+        }
+    }
+
+    // Nombre d'éléments de clé dans [lo, hi], -1 en cas d'erreur
+    template <typename K>
+    int count(const std::string& index, const K& lo, const K& hi) {
+        Response response;
+        if (call(response, Opcode::COUNT, index, lo, hi) != ResponseStatus::OK) {
+            return -1;
+        }
+        FrameReader reader = response.reader();
+        uint32_t count;
+        return reader.get(count) ? static_cast<int>(count) : -1;
+    }
+
+    template <typename K, typename V>
+    bool add(const std::string& index, const K& key, const V& value) {
+        Response response;
+        return call(response, Opcode::ADD, index, key, value) == ResponseStatus::OK;
+    }
+
+    // false si l'élément est absent ou en cas d'erreur
+    template <typename K, typename V>
+    bool remove(const std::string& index, const K& key, const V& value) {
+        Response response;
+        return call(response, Opcode::DELETE, index, key, value) == ResponseStatus::OK;
+    }
+
+    template <typename K>
+    bool removeNode(const std::string& index, const K& key) {
+        Response response;
+        return call(response, Opcode::DELETE_NODE, index, key) == ResponseStatus::OK;
+    }
+
+    bool stats(const std::string& index, RemoteStats& stats) {
+        Response response;
+        if (call(response, Opcode::STATS, index) != ResponseStatus::OK) {
+            return false;
+        }
+        FrameReader reader = response.reader();
+        return (reader.get(stats.keyTag) && reader.get(stats.valueTag) && reader.get(stats.nbNodes)
+                && reader.get(stats.nbElements) && reader.get(stats.bytes)) || fail("Réponse mal formée");
+    }
+
+private:
+    int fd = -1;
+    uint32_t nextId = 0;
+    std::string output;        // Requêtes en file
+    std::string input;         // Octets reçus, à partir de inputOffset
+    size_t inputOffset = 0;
+    std::string lastError;
+
+    bool fail(const std::string& message) {
+        lastError = message;
+        return false;
+    }
+
+    bool connectTo(const sockaddr* address, socklen_t length) {
+        if (fd < 0 || connect(fd, address, length) < 0) {
+            lastError = std::string("Connexion impossible: ") + std::strerror(errno);
+            disconnect();
+            return false;
+        }
+        return true;
+    }
+
+    template <typename T>
+    static void putArgument(FrameWriter& frame, const T& value) {
+        frame.put(value);
+    }
+
+    template <typename T>
+    static void putArgument(FrameWriter& frame, const std::vector<T>& values) {
+        frame.put(static_cast<uint32_t>(values.size()));
+        for (const T& value : values) {
+            frame.put(value);
+        }
+    }
+
+    template <typename V>
+    static bool readValues(FrameReader& reader, std::vector<V>& values) {
+        uint32_t size;
+        if (!reader.get(size)) {
+            return false;
+        }
+        values.resize(size);
+        for (auto& value : values) {
+            if (!reader.get(value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+#endif // INDEX_CLIENT_H
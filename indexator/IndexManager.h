@@ -6,11 +6,55 @@
 #include <memory>
 #include <variant>
 #include <type_traits>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+#include <charconv>
 #include "Element.h"
 #include "Node.h"
 #include "Index.h"
+#include "ThreadPool.h"
+#include "QueryExecutor.h"
+#include "BufferedWriter.h"
+#include "ResultWriter.h"
+#include "ExternalBuilder.h"
 
-// Classe pour gérer différents types d'index
+// Options du mode batch (voir IndexManager::runBatch)
+struct BatchOptions {
+    bool timing = false;                      // Durée d'exécution de chaque commande
+    size_t offset = 0;                        // Page des résultats de get et range
+    size_t limit = static_cast<size_t>(-1);
+};
+
+// Bilan du chargement d'un fichier (voir IndexManager::loadDirectory)
+struct FileLoadReport {
+    std::string filename;
+    bool loaded = false;
+    size_t lines = 0;
+    size_t errors = 0;     // Lignes mal formatées ignorées
+    size_t bytes = 0;
+    double ms = 0.0;       // Lecture et analyse (et tri de la suite d'un chargement fusionné)
+
+    double megabytesPerSecond() const {
+        return ms > 0.0 ? bytes / 1e3 / ms : 0.0;
+    }
+};
+
+// Classe pour gérer différents types d'index.
+// Les index chargés sont enregistrés sous un nom (par défaut, le nom du fichier) et l'on
+// passe de l'un à l'autre sans rechargement. Avec un budget mémoire, les index les moins
+// récemment utilisés sont évincés dans un instantané binaire, relu à leur réactivation.
+// Les chargements se font en arrière-plan dans un index neuf : l'index courant reste
+// interrogeable et n'est remplacé qu'à la fin du chargement, par adoptPendingLoad().
 class IndexManager {
 private:
     enum class IndexType {
@@ -20,25 +64,750 @@ private:
         INT_INT
     };
 
+    // Index actif (appartient au registre)
     Index<char, std::string>* charStringIndex = nullptr;
     Index<int, std::string>* intStringIndex = nullptr;
     Index<int, int>* intIntIndex = nullptr;
     IndexType currentType = IndexType::NONE;
 
-    // Libère la mémoire des index
-    void clearIndices() {
-        if (charStringIndex) {
-            delete charStringIndex;
-            charStringIndex = nullptr;
+    // Index enregistré : un seul pointeur non nul selon le type, ou aucun s'il est évincé
+    struct Entry {
+        IndexType type = IndexType::NONE;
+        Index<char, std::string>* charStringIndex = nullptr;
+        Index<int, std::string>* intStringIndex = nullptr;
+        Index<int, int>* intIntIndex = nullptr;
+        std::string snapshotFile;   // Instantané binaire de l'index évincé
+        uint64_t lastUse = 0;       // Horloge logique pour l'éviction LRU
+
+        bool isResident() const {
+            return charStringIndex || intStringIndex || intIntIndex;
+        }
+    };
+
+    std::map<std::string, Entry> registry;
+    std::string currentName;
+    uint64_t useClock = 0;
+    size_t memoryBudget = 0;   // Octets pour les index résidents, 0 : illimité
+    std::string snapshotDirectory = std::filesystem::temp_directory_path().string();
+    unsigned snapshotCounter = 0;
+    size_t pageSize = 50;      // Éléments par page à l'affichage, 0 : tout afficher d'un bloc
+
+    // Chargement en arrière-plan : le thread ne touche qu'à cette structure
+    struct BackgroundLoad {
+        std::thread worker;
+        LoadProgress progress;
+        std::string filename;
+        std::string name;
+        std::atomic<bool> finished{false};
+        bool snapshot = false;   // Instantané binaire (loadSnapshot) plutôt que fichier texte
+        Entry result;   // Index chargé, vide en cas d'échec
+    };
+
+    std::unique_ptr<BackgroundLoad> pendingLoad;
+
+    // Libère les index remplacés ou retirés, hors du chemin critique : un seul thread, lancé
+    // à la première libération, vide une file d'entrées. Mettre en file n'attend jamais la
+    // fin d'une libération précédente ; la destruction vide la file puis arrête le thread.
+    class Releaser {
+    public:
+        Releaser() {}
+
+        Releaser(const Releaser&) = delete;
+        Releaser& operator=(const Releaser&) = delete;
+
+        ~Releaser() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_one();
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+
+        void release(const Entry& entry) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push_back(entry);
+                if (!worker.joinable()) {
+                    worker = std::thread([this]() { run(); });
+                }
+            }
+            wake.notify_one();
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::vector<Entry> queue;
+        bool stopping = false;
+        std::thread worker;
+
+        void run() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                wake.wait(lock, [this]() { return stopping || !queue.empty(); });
+                if (queue.empty()) {
+                    return;   // Arrêt demandé, file vidée
+                }
+                std::vector<Entry> batch;
+                batch.swap(queue);
+                lock.unlock();
+                for (const Entry& entry : batch) {
+                    delete entry.charStringIndex;
+                    delete entry.intStringIndex;
+                    delete entry.intIntIndex;
+                }
+                lock.lock();
+            }
+        }
+    };
+
+    Releaser releaser;
+
+    static const char* typeName(IndexType type) {
+        switch (type) {
+            case IndexType::CHAR_STRING: return "Char/String";
+            case IndexType::INT_STRING: return "Int/String";
+            case IndexType::INT_INT: return "Int/Int";
+            default: return "inconnu";
+        }
+    }
+
+    // Résumé d'une relecture différentielle
+    template <typename K>
+    static void printReloadSummary(const ReloadSummary<K>& summary, double ms) {
+        std::cout << summary.added << " élément(s) ajouté(s), " << summary.removed << " supprimé(s), "
+                  << summary.unchanged << " inchangé(s) ; " << summary.nodesAdded << " clé(s) nouvelle(s), "
+                  << summary.nodesRemoved << " disparue(s), " << summary.changedKeys.size()
+                  << " clé(s) modifiée(s) au total (" << ms << " ms)." << std::endl;
+    }
+
+    // Lance le chargement de filename dans un index neuf, rangé dans load->result.*result ;
+    // avec snapshot, filename est un instantané binaire relu par loadSnapshot
+    template <typename K, typename V>
+    bool startLoad(IndexType type, const std::string& filename, const std::string& name,
+                   Index<K, V>* Entry::* result, bool snapshot = false) {
+        if (!std::ifstream(filename).is_open()) {
+            std::cerr << "Erreur: Impossible d'ouvrir le fichier " << filename << std::endl;
+            return false;
+        }
+        cancelLoad();
+
+        pendingLoad = std::make_unique<BackgroundLoad>();
+        BackgroundLoad* load = pendingLoad.get();
+        load->filename = filename;
+        load->name = name.empty() ? filename : name;
+        load->result.type = type;
+        load->snapshot = snapshot;
+        load->worker = std::thread([load, result]() {
+            auto* loaded = new Index<K, V>();
+            bool ok = load->snapshot ? loaded->loadSnapshot(load->filename, &load->progress)
+                                     : loaded->loadFromFile(load->filename, &load->progress);
+            if (ok) {
+                load->result.*result = loaded;
+            } else {
+                delete loaded;
+            }
+            load->finished.store(true, std::memory_order_release);
+        });
+        return true;
+    }
+
+    // Chargement de tous les fichiers de path en index de type K/V (voir loadDirectory)
+    template <typename K, typename V>
+    bool loadDirectoryAs(IndexType type, Index<K, V>* Entry::* result, const std::string& path,
+                         size_t threads, bool merge, std::vector<FileLoadReport>& reports) {
+        std::error_code error;
+        std::vector<std::string> files;
+        for (const auto& item : std::filesystem::directory_iterator(path, error)) {
+            if (item.is_regular_file()) {
+                files.push_back(item.path().string());
+            }
+        }
+        if (error) {
+            std::cerr << "Erreur: Impossible de lire le répertoire " << path << std::endl;
+            return false;
+        }
+        std::sort(files.begin(), files.end());
+
+        std::unique_ptr<ThreadPool> ownPool;
+        if (threads > 0) {
+            ownPool = std::make_unique<ThreadPool>(threads);
+        }
+        ThreadPool& pool = ownPool ? *ownPool : ThreadPool::instance();
+
+        // Un fichier par tâche : un index chacun, ou une suite d'éléments triée à fusionner
+        auto start = std::chrono::steady_clock::now();
+        reports.assign(files.size(), FileLoadReport());
+        std::vector<std::vector<Element<K, V>*>> runs(merge ? files.size() : 0);
+        std::vector<Index<K, V>*> loaded(files.size(), nullptr);
+        {
+            TaskGroup group(pool);
+            for (size_t i = 0; i < files.size(); ++i) {
+                group.run([&, i]() {
+                    FileLoadReport& report = reports[i];
+                    report.filename = files[i];
+                    LoadProgress progress;
+                    auto fileStart = std::chrono::steady_clock::now();
+                    if (merge) {
+                        report.loaded = Index<K, V>::readElements(files[i], runs[i], &progress);
+                        std::sort(runs[i].begin(), runs[i].end(), [](const Element<K, V>* a, const Element<K, V>* b) {
+                            return *a < *b;
+                        });
+                    } else {
+                        auto* index = new Index<K, V>();
+                        report.loaded = index->loadFromFile(files[i], &progress, pool);
+                        if (report.loaded) {
+                            loaded[i] = index;
+                        } else {
+                            delete index;
+                        }
+                    }
+                    report.lines = progress.lines;
+                    report.errors = progress.errors;
+                    report.bytes = progress.bytesRead;
+                    report.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - fileStart).count();
+                });
+            }
+        }
+
+        size_t nbLoaded = 0, bytes = 0, elements = 0;
+        for (const auto& report : reports) {
+            if (report.loaded) {
+                ++nbLoaded;
+                bytes += report.bytes;
+            }
+        }
+        if (nbLoaded == 0) {
+            std::cout << "Aucun fichier chargé depuis " << path << "." << std::endl;
+            return false;
+        }
+
+        if (merge) {
+            auto* merged = new Index<K, V>();
+            merged->mergeSortedRuns(runs, pool);
+            elements = static_cast<size_t>(merged->getNbElements());
+            Entry entry;
+            entry.type = type;
+            entry.*result = merged;
+            registerIndex(path, entry);
+        } else {
+            for (size_t i = 0; i < files.size(); ++i) {
+                if (loaded[i] != nullptr) {
+                    elements += static_cast<size_t>(loaded[i]->getNbElements());
+                    Entry entry;
+                    entry.type = type;
+                    entry.*result = loaded[i];
+                    registerIndex(files[i], entry);
+                }
+            }
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        for (const auto& report : reports) {
+            std::cout << "  " << report.filename << " : ";
+            if (report.loaded) {
+                std::cout << report.lines << " lignes, " << report.errors << " erreur(s), "
+                          << report.megabytesPerSecond() << " Mo/s" << std::endl;
+            } else {
+                std::cout << "échec" << std::endl;
+            }
+        }
+        std::cout << nbLoaded << " fichier(s) sur " << files.size() << " chargé(s) depuis " << path
+                  << (merge ? " dans un seul index" : "") << " : " << elements << " éléments, "
+                  << bytes / 1e6 << " Mo en " << ms << " ms (" << (ms > 0.0 ? bytes / 1e3 / ms : 0.0)
+                  << " Mo/s, " << pool.size() << " thread(s))." << std::endl;
+        return true;
+    }
+
+    // Construction d'un instantané de type K/V par tri externe (voir buildSnapshot)
+    template <typename K, typename V>
+    static bool buildSnapshotAs(const std::string& input, const std::string& output, size_t memoryBytes) {
+        ExternalBuilder<K, V> builder(memoryBytes);
+        if (!builder.build(input, output)) {
+            return false;
+        }
+        const ExternalBuildStats& stats = builder.getStats();
+        std::cout << "Instantané " << output << " : " << stats.elements << " éléments, " << stats.nodes
+                  << " clés, " << stats.errors << " lignes ignorées ; " << stats.runs << " suites temporaires, "
+                  << stats.mergePasses << " passes de fusion ; " << stats.ms << " ms ("
+                  << stats.megabytesPerSecond() << " Mo/s)" << std::endl;
+        return true;
+    }
+
+    // Exécute en parallèle les requêtes d'un lot sur un instantané de index et affiche
+    // les résultats dans l'ordre du fichier
+    template <typename K, typename V>
+    void runQueryBatch(const Index<K, V>& index, const std::vector<std::string>& lines) {
+        std::vector<Query<K>> queries;
+        std::vector<const std::string*> texts;
+        int ignored = 0;
+        for (const auto& line : lines) {
+            Query<K> query;
+            if (QueryExecutor<K, V>::parseQuery(line, query)) {
+                queries.push_back(query);
+                texts.push_back(&line);
+            } else if (!isBlankOrComment(line)) {
+                std::cerr << "Avertissement: Requête invalide ignorée: " << line << std::endl;
+                ++ignored;
+            }
+        }
+
+        QueryExecutor<K, V> executor;
+        BatchResult<K, V> batch = executor.execute(index, queries);
+
+        for (size_t i = 0; i < queries.size(); ++i) {
+            const QueryResult<K, V>& result = batch.results[i];
+            std::cout << "[" << (i + 1) << "] " << *texts[i] << " : " << result.count << " élément(s)\n";
+            for (const auto* element : result.elements) {
+                std::cout << "    " << *element << '\n';
+            }
+        }
+        // Un seul vidage, par le std::endl du bilan
+        std::cout << queries.size() << " requête(s) exécutée(s) en " << batch.latencyMs << " ms sur "
+                  << ThreadPool::instance().size() << " thread(s)";
+        if (ignored > 0) {
+            std::cout << ", " << ignored << " ignorée(s)";
+        }
+        std::cout << "." << std::endl;
+    }
+
+    // Entre deux pages : propose d'afficher la suite ; false pour arrêter (ou en fin d'entrée)
+    static bool askForMore(size_t remaining) {
+        std::cout << "-- " << remaining << " élément(s) restant(s) : Entrée pour la suite, q pour arrêter -- "
+                  << std::flush;
+        std::string answer;
+        return std::getline(std::cin, answer) && answer != "q" && answer != "Q";
+    }
+
+    // Affiche index par pages de pageSize éléments, en reprenant au curseur de la page
+    // précédente ; d'un bloc, avec formatage parallèle, si pageSize vaut 0
+    template <typename K, typename V>
+    void displayIndexPages(const Index<K, V>& index) const {
+        BufferedWriter out(std::cout);
+        ResultWriter<K, V> writer(out);
+        std::vector<Element<K, V>*> page;
+        PageCursor cursor;
+        if (pageSize == 0) {
+            index.collectPage(cursor, ResultWriter<K, V>::NoLimit, page);
+            writer.writeParallel(page);
+            return;
+        }
+        while (!cursor.done) {
+            page.clear();
+            index.collectPage(cursor, pageSize, page);
+            writer.write(page.begin(), page.end());
+            size_t remaining = static_cast<size_t>(index.getNbElements()) - writer.getWritten();
+            if (cursor.done || remaining == 0) {
+                break;
+            }
+            out.flush();
+            if (!askForMore(remaining)) {
+                break;
+            }
+        }
+    }
+
+    // Enregistre un index chargé sous name, en remplaçant celui de même nom, et l'active
+    void registerIndex(const std::string& name, const Entry& entry) {
+        auto it = registry.find(name);
+        if (it != registry.end()) {
+            dropEntry(it->second);
+            it->second = entry;
+        } else {
+            registry.emplace(name, entry);
+        }
+        activateIndex(name);
+    }
+
+    // Commande du mode batch : mot-clé, champs suivants et texte qui suit le premier champ
+    // (valeur d'un add ou d'un del, qui peut contenir des espaces)
+    struct BatchCommand {
+        int line = 0;
+        std::string name;
+        std::vector<std::string> fields;
+        std::string rest;
+        BatchOptions options;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // Conversions strictes des champs d'une commande
+    static bool parseField(const std::string& text, int& value) {
+        const char* end = text.data() + text.size();
+        auto result = std::from_chars(text.data(), end, value);
+        return result.ec == std::errc() && result.ptr == end;
+    }
+
+    static bool parseField(const std::string& text, char& value) {
+        value = text.empty() ? '\0' : text[0];
+        return text.size() == 1;
+    }
+
+    static bool parseField(const std::string& text, std::string& value) {
+        value = text;
+        return !text.empty();
+    }
+
+    // Ligne de statut d'une commande : statut, commande, résultat et, avec timing, durée
+    // d'exécution en microsecondes, séparés par des tabulations
+    template <typename R>
+    static void writeStatus(BufferedWriter& out, const char* status, const BatchCommand& command, const R& result) {
+        out << status << '\t' << command.name << '\t' << result;
+        if (command.options.timing) {
+            out << '\t' << std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - command.start).count();
+        }
+        out << '\n';
+    }
+
+    static void writeError(BufferedWriter& out, const BatchCommand& command, const std::string& message) {
+        writeStatus(out, "error", command, "ligne " + std::to_string(command.line) + ": " + message);
+    }
+
+    // Résultat d'un get ou d'un range : nombre de lignes de la page, puis une ligne par élément
+    template <typename K, typename V, typename Pointer>
+    static void writeElementPage(BufferedWriter& out, const BatchCommand& command, const std::vector<Pointer>& elements) {
+        size_t offset = std::min(command.options.offset, elements.size());
+        writeStatus(out, "ok", command, std::min(command.options.limit, elements.size() - offset));
+        ResultWriter<K, V> writer(out, ResultFormat::TSV, command.options.offset, command.options.limit);
+        writer.write(elements.begin(), elements.end());
+    }
+
+    template <typename K, typename V>
+    static void writeElements(BufferedWriter& out, const BatchCommand& command, const std::vector<Element<K, V>*>& elements) {
+        writeElementPage<K, V>(out, command, elements);
+    }
+
+    template <typename K, typename V>
+    static void writeElements(BufferedWriter& out, const BatchCommand& command,
+                              const std::vector<const Element<K, V>*>& elements) {
+        writeElementPage<K, V>(out, command, elements);
+    }
+
+    // Ligne sans commande : vide ou commentaire (#)
+    static bool isBlankOrComment(const std::string& line) {
+        size_t first = line.find_first_not_of(" \t\r");
+        return first == std::string::npos || line[first] == '#';
+    }
+
+    // query <fichier> du mode batch : les requêtes du fichier (get, count, range) sont
+    // exécutées en parallèle sur un instantané de index (QueryExecutor). Une ligne de
+    // statut donne leur nombre, puis chaque requête produit la même sortie que la commande
+    // correspondante. Une requête invalide fait échouer la commande sans rien exécuter.
+    template <typename K, typename V>
+    bool runBatchQueries(const Index<K, V>& index, const BatchCommand& command, BufferedWriter& out) {
+        if (command.fields.size() != 1) {
+            writeError(out, command, "usage: query <fichier>");
+            return false;
+        }
+        std::ifstream file(command.fields[0]);
+        if (!file.is_open()) {
+            writeError(out, command, "impossible de lire " + command.fields[0]);
+            return false;
+        }
+        std::vector<Query<K>> queries;
+        std::string line;
+        for (int number = 1; std::getline(file, line); ++number) {
+            Query<K> query;
+            if (QueryExecutor<K, V>::parseQuery(line, query)) {
+                queries.push_back(query);
+            } else if (!isBlankOrComment(line)) {
+                writeError(out, command, command.fields[0] + " ligne " + std::to_string(number) + ": requête invalide");
+                return false;
+            }
+        }
+
+        QueryExecutor<K, V> executor;
+        BatchResult<K, V> batch = executor.execute(index, queries);
+        writeStatus(out, "ok", command, queries.size());
+
+        BatchCommand result = command;
+        result.options.timing = false;   // Seule la commande query est chronométrée
+        for (size_t i = 0; i < queries.size(); ++i) {
+            switch (queries[i].type) {
+                case Query<K>::Type::GET:
+                    result.name = "get";
+                    writeElements(out, result, batch.results[i].elements);
+                    break;
+                case Query<K>::Type::COUNT:
+                    result.name = "count";
+                    writeStatus(out, "ok", result, batch.results[i].count);
+                    break;
+                case Query<K>::Type::RANGE:
+                    result.name = "range";
+                    writeElements(out, result, batch.results[i].elements);
+                    break;
+            }
+        }
+        return true;
+    }
+
+    // Exécute une commande du mode batch sur index ; retourne false en cas d'erreur
+    template <typename K, typename V>
+    bool runBatchCommand(Index<K, V>& index, const BatchCommand& command, BufferedWriter& out) {
+        const std::vector<std::string>& fields = command.fields;
+        K key{}, hi{};
+        V value{};
+
+        if (command.name == "get") {
+            if (fields.size() != 1 || !parseField(fields[0], key)) {
+                writeError(out, command, "usage: get <clé>");
+                return false;
+            }
+            writeElements(out, command, index.getElements(key));
+        } else if (command.name == "range") {
+            if (fields.size() != 2 || !parseField(fields[0], key) || !parseField(fields[1], hi)) {
+                writeError(out, command, "usage: range <clé_min> <clé_max>");
+                return false;
+            }
+            writeElements(out, command, index.getRange(key, hi));
+        } else if (command.name == "query") {
+            return runBatchQueries(index, command, out);
+        } else if (command.name == "count") {
+            if (fields.empty()) {
+                writeStatus(out, "ok", command, index.getNbElements());
+            } else if (fields.size() <= 2 && parseField(fields[0], key) && parseField(fields.back(), hi)) {
+                writeStatus(out, "ok", command, index.countRange(key, hi));
+            } else {
+                writeError(out, command, "usage: count [<clé_min> [<clé_max>]]");
+                return false;
+            }
+        } else if (command.name == "add" || command.name == "del") {
+            if (fields.size() < 2 || !parseField(fields[0], key) || !parseField(command.rest, value)) {
+                writeError(out, command, "usage: " + command.name + " <clé> <valeur>");
+                return false;
+            }
+            if (command.name == "add") {
+                index.addElement(new Element<K, V>(key, value));
+                writeStatus(out, "ok", command, 1);
+            } else {
+                Element<K, V> target(key, value);
+                bool deleted = index.deleteElement(&target);
+                writeStatus(out, deleted ? "ok" : "notfound", command, deleted ? 1 : 0);
+            }
+        } else if (command.name == "delnode") {
+            if (fields.size() != 1 || !parseField(fields[0], key)) {
+                writeError(out, command, "usage: delnode <clé>");
+                return false;
+            }
+            size_t size = index.getElements(key).size();
+            bool deleted = index.deleteNode(key);
+            writeStatus(out, deleted ? "ok" : "notfound", command, size);
+        } else if (command.name == "save") {
+            if (fields.size() != 1) {
+                writeError(out, command, "usage: save <fichier>");
+                return false;
+            }
+            if (!index.saveSnapshot(fields[0])) {
+                writeError(out, command, "impossible d'écrire " + fields[0]);
+                return false;
+            }
+            writeStatus(out, "ok", command, index.getNbElements());
+        } else if (command.name == "reload") {
+            if (fields.size() != 1) {
+                writeError(out, command, "usage: reload <fichier>");
+                return false;
+            }
+            ReloadSummary<K> summary;
+            if (!index.reloadFromFile(fields[0], &summary)) {
+                writeError(out, command, "impossible de lire " + fields[0]);
+                return false;
+            }
+            writeStatus(out, "ok", command, summary.added + summary.removed);
+        } else if (command.name == "export") {
+            if (fields.size() != 1) {
+                writeError(out, command, "usage: export <fichier>");
+                return false;
+            }
+            if (!index.saveToFile(fields[0])) {
+                writeError(out, command, "impossible d'écrire " + fields[0]);
+                return false;
+            }
+            writeStatus(out, "ok", command, index.getNbElements());
+        } else {
+            writeError(out, command, "commande inconnue");
+            return false;
+        }
+        return true;
+    }
+
+    // Chargement synchrone du mode batch : load <type> <fichier> [nom]
+    bool runBatchLoad(const BatchCommand& command, BufferedWriter& out) {
+        const std::vector<std::string>& fields = command.fields;
+        if (fields.size() < 2 || fields.size() > 3) {
+            writeError(out, command, "usage: " + command.name + " cs|is|ii <fichier> [nom]");
+            return false;
+        }
+        const std::string& type = fields[0];
+        const std::string& name = fields.size() == 3 ? fields[2] : fields[1];
+        bool snapshot = command.name == "loadsnap";
+        bool started = false;
+        if (type == "cs") {
+            started = startLoad(IndexType::CHAR_STRING, fields[1], name, &Entry::charStringIndex, snapshot);
+        } else if (type == "is") {
+            started = startLoad(IndexType::INT_STRING, fields[1], name, &Entry::intStringIndex, snapshot);
+        } else if (type == "ii") {
+            started = startLoad(IndexType::INT_INT, fields[1], name, &Entry::intIntIndex, snapshot);
+        } else {
+            writeError(out, command, "type inconnu: " + type);
+            return false;
+        }
+        if (!started) {
+            writeError(out, command, "impossible d'ouvrir " + fields[1]);
+            return false;
+        }
+
+        pendingLoad->worker.join();
+        std::unique_ptr<BackgroundLoad> load = std::move(pendingLoad);
+        if (!load->result.isResident()) {
+            writeError(out, command, "échec du chargement de " + fields[1]);
+            return false;
+        }
+        registerIndex(load->name, load->result);
+        writeStatus(out, "ok", command, currentElementCount());
+        return true;
+    }
+
+    int currentElementCount() const {
+        switch (currentType) {
+            case IndexType::CHAR_STRING: return charStringIndex->getNbElements();
+            case IndexType::INT_STRING: return intStringIndex->getNbElements();
+            case IndexType::INT_INT: return intIntIndex->getNbElements();
+            default: return 0;
+        }
+    }
+
+    // Confie les index d'une entrée au thread de libération
+    void releaseInBackground(Entry& entry) {
+        if (!entry.isResident()) {
+            return;
+        }
+        releaser.release(entry);
+        entry.charStringIndex = nullptr;
+        entry.intStringIndex = nullptr;
+        entry.intIntIndex = nullptr;
+    }
+
+    // Estimation mémoire d'un index résident
+    static size_t residentBytes(const Entry& entry) {
+        switch (entry.type) {
+            case IndexType::CHAR_STRING:
+                return entry.charStringIndex ? entry.charStringIndex->getStats().totalBytes() : 0;
+            case IndexType::INT_STRING:
+                return entry.intStringIndex ? entry.intStringIndex->getStats().totalBytes() : 0;
+            case IndexType::INT_INT:
+                return entry.intIntIndex ? entry.intIntIndex->getStats().totalBytes() : 0;
+            default:
+                return 0;
+        }
+    }
+
+    // Évince un index résident dans un instantané binaire
+    bool evict(const std::string& name, Entry& entry) {
+        if (entry.snapshotFile.empty()) {
+            entry.snapshotFile = (std::filesystem::path(snapshotDirectory)
+                                  / ("indexator-" + std::to_string(reinterpret_cast<uintptr_t>(this))
+                                     + "-" + std::to_string(++snapshotCounter) + ".idx")).string();
+        }
+
+        bool saved = false;
+        switch (entry.type) {
+            case IndexType::CHAR_STRING:
+                saved = entry.charStringIndex->saveSnapshot(entry.snapshotFile);
+                break;
+            case IndexType::INT_STRING:
+                saved = entry.intStringIndex->saveSnapshot(entry.snapshotFile);
+                break;
+            case IndexType::INT_INT:
+                saved = entry.intIntIndex->saveSnapshot(entry.snapshotFile);
+                break;
+            default:
+                break;
+        }
+        if (!saved) {
+            std::cerr << "Erreur: Impossible d'évincer l'index " << name << std::endl;
+            return false;
+        }
+        releaseInBackground(entry);
+        return true;
+    }
+
+    // Recharge un index évincé depuis son instantané
+    bool restore(const std::string& name, Entry& entry) {
+        bool loaded = false;
+        switch (entry.type) {
+            case IndexType::CHAR_STRING:
+                entry.charStringIndex = new Index<char, std::string>();
+                loaded = entry.charStringIndex->loadSnapshot(entry.snapshotFile);
+                break;
+            case IndexType::INT_STRING:
+                entry.intStringIndex = new Index<int, std::string>();
+                loaded = entry.intStringIndex->loadSnapshot(entry.snapshotFile);
+                break;
+            case IndexType::INT_INT:
+                entry.intIntIndex = new Index<int, int>();
+                loaded = entry.intIntIndex->loadSnapshot(entry.snapshotFile);
+                break;
+            default:
+                break;
+        }
+        if (!loaded) {
+            std::cerr << "Erreur: Impossible de réactiver l'index " << name << std::endl;
+            releaseInBackground(entry);
+            return false;
+        }
+        return true;
+    }
+
+    // Évince les index les moins récemment utilisés (sauf l'index actif) jusqu'à respecter
+    // le budget mémoire
+    void enforceBudget() {
+        if (memoryBudget == 0) {
+            return;
         }
-        if (intStringIndex) {
-            delete intStringIndex;
-            intStringIndex = nullptr;
+        size_t total = 0;
+        for (const auto& item : registry) {
+            total += residentBytes(item.second);
         }
-        if (intIntIndex) {
-            delete intIntIndex;
-            intIntIndex = nullptr;
+        while (total > memoryBudget) {
+            auto victim = registry.end();
+            for (auto it = registry.begin(); it != registry.end(); ++it) {
+                if (it->first != currentName && it->second.isResident()
+                    && (victim == registry.end() || it->second.lastUse < victim->second.lastUse)) {
+                    victim = it;
+                }
+            }
+            if (victim == registry.end()) {
+                break;  // Seul l'index actif reste en mémoire
+            }
+            size_t bytes = residentBytes(victim->second);
+            if (!evict(victim->first, victim->second)) {
+                break;
+            }
+            total -= bytes;
         }
+    }
+
+    // Retire une entrée du registre et libère son index et son instantané
+    void dropEntry(Entry& entry) {
+        releaseInBackground(entry);
+        if (!entry.snapshotFile.empty()) {
+            std::error_code error;
+            std::filesystem::remove(entry.snapshotFile, error);
+        }
+    }
+
+    // Libère la mémoire des index
+    void clearIndices() {
+        for (auto& item : registry) {
+            dropEntry(item.second);
+        }
+        registry.clear();
+        currentName.clear();
+        charStringIndex = nullptr;
+        intStringIndex = nullptr;
+        intIntIndex = nullptr;
         currentType = IndexType::NONE;
     }
 
@@ -48,46 +817,245 @@ public:
 
     // Destructeur
     ~IndexManager() {
-        clearIndices();
+        cancelLoad();
+        clearIndices();   // Index libérés par releaser, vidé à sa destruction
+    }
+
+    // Méthodes pour charger différents types d'index existants.
+    // Le chargement est lancé en arrière-plan (un éventuel chargement en cours est annulé) ;
+    // l'index sera enregistré sous name (par défaut filename), en remplaçant celui de même nom.
+    // Retourne false si le fichier ne peut pas être ouvert.
+    bool loadCharStringIndex(const std::string& filename, const std::string& name = "") {
+        return startLoad(IndexType::CHAR_STRING, filename, name, &Entry::charStringIndex);
+    }
+
+    bool loadIntStringIndex(const std::string& filename, const std::string& name = "") {
+        return startLoad(IndexType::INT_STRING, filename, name, &Entry::intStringIndex);
     }
 
-    // Méthodes pour charger différents types d'index existants
-    bool loadCharStringIndex(const std::string& filename) {
-        clearIndices();
-        charStringIndex = new Index<char, std::string>();
-        if (charStringIndex->loadFromFile(filename)) {
-            currentType = IndexType::CHAR_STRING;
-            return true;
+    bool loadIntIntIndex(const std::string& filename, const std::string& name = "") {
+        return startLoad(IndexType::INT_INT, filename, name, &Entry::intIntIndex);
+    }
+
+    // Charge en arrière-plan, comme les fichiers texte, un instantané binaire (écrit par
+    // buildSnapshot ou saveSnapshot) ; type est cs, is ou ii. Un instantané d'un autre type
+    // est refusé à la fin du chargement, l'index courant étant conservé.
+    bool loadSnapshot(const std::string& filename, const std::string& type, const std::string& name = "") {
+        if (type == "cs") {
+            return startLoad(IndexType::CHAR_STRING, filename, name, &Entry::charStringIndex, true);
+        } else if (type == "is") {
+            return startLoad(IndexType::INT_STRING, filename, name, &Entry::intStringIndex, true);
+        } else if (type == "ii") {
+            return startLoad(IndexType::INT_INT, filename, name, &Entry::intIntIndex, true);
         }
-        delete charStringIndex;
-        charStringIndex = nullptr;
+        std::cerr << "Erreur: Type d'index inconnu: " << type << std::endl;
         return false;
     }
 
-    bool loadIntStringIndex(const std::string& filename) {
-        clearIndices();
-        intStringIndex = new Index<int, std::string>();
-        if (intStringIndex->loadFromFile(filename)) {
-            currentType = IndexType::INT_STRING;
-            return true;
+    // Charge en parallèle tous les fichiers du répertoire path, sur threads threads (0 : la
+    // réserve commune) : lecture, tri de chaque fichier et fusion finale restent sur ces
+    // threads. type est cs (Char/String), is (Int/String) ou ii (Int/Int). Chaque fichier
+    // devient un index enregistré sous son chemin ; avec merge, tous forment un seul index
+    // enregistré sous path, fusionné depuis une suite triée par fichier. Le bilan de chaque
+    // fichier est affiché, et copié dans reports s'il est fourni. Le dernier index enregistré
+    // devient actif. Retourne false si aucun fichier n'a pu être chargé.
+    bool loadDirectory(const std::string& path, const std::string& type, size_t threads = 0,
+                       bool merge = false, std::vector<FileLoadReport>* reports = nullptr) {
+        std::vector<FileLoadReport> local;
+        std::vector<FileLoadReport>& files = reports != nullptr ? *reports : local;
+        if (type == "cs") {
+            return loadDirectoryAs(IndexType::CHAR_STRING, &Entry::charStringIndex, path, threads, merge, files);
+        } else if (type == "is") {
+            return loadDirectoryAs(IndexType::INT_STRING, &Entry::intStringIndex, path, threads, merge, files);
+        } else if (type == "ii") {
+            return loadDirectoryAs(IndexType::INT_INT, &Entry::intIntIndex, path, threads, merge, files);
         }
-        delete intStringIndex;
-        intStringIndex = nullptr;
+        std::cerr << "Erreur: Type d'index inconnu: " << type << std::endl;
         return false;
     }
 
-    bool loadIntIntIndex(const std::string& filename) {
-        clearIndices();
-        intIntIndex = new Index<int, int>();
-        if (intIntIndex->loadFromFile(filename)) {
-            currentType = IndexType::INT_INT;
-            return true;
+    // Construit depuis le fichier texte input l'instantané binaire output, sans charger
+    // l'index : tri externe en mémoire bornée à memoryMegabytes Mo, pour les fichiers plus
+    // grands que la mémoire. type est cs, is ou ii. L'instantané se relit par loadSnapshot.
+    bool buildSnapshot(const std::string& input, const std::string& output, const std::string& type,
+                       size_t memoryMegabytes = 256) {
+        size_t memoryBytes = memoryMegabytes << 20;
+        if (type == "cs") {
+            return buildSnapshotAs<char, std::string>(input, output, memoryBytes);
+        } else if (type == "is") {
+            return buildSnapshotAs<int, std::string>(input, output, memoryBytes);
+        } else if (type == "ii") {
+            return buildSnapshotAs<int, int>(input, output, memoryBytes);
         }
-        delete intIntIndex;
-        intIntIndex = nullptr;
+        std::cerr << "Erreur: Type d'index inconnu: " << type << std::endl;
         return false;
     }
 
+    // Rend actif l'index enregistré sous name, en le rechargeant s'il a été évincé
+    bool activateIndex(const std::string& name) {
+        auto it = registry.find(name);
+        if (it == registry.end()) {
+            return false;
+        }
+        Entry& entry = it->second;
+        if (!entry.isResident() && !restore(name, entry)) {
+            return false;
+        }
+
+        entry.lastUse = ++useClock;
+        currentName = name;
+        currentType = entry.type;
+        charStringIndex = entry.charStringIndex;
+        intStringIndex = entry.intStringIndex;
+        intIntIndex = entry.intIntIndex;
+        enforceBudget();
+        return true;
+    }
+
+    // Retire un index du registre (l'index actif ne peut pas être retiré)
+    bool removeIndex(const std::string& name) {
+        auto it = registry.find(name);
+        if (it == registry.end() || name == currentName) {
+            return false;
+        }
+        dropEntry(it->second);
+        registry.erase(it);
+        return true;
+    }
+
+    // Budget mémoire des index résidents, en octets (0 : illimité)
+    void setMemoryBudget(size_t bytes) {
+        memoryBudget = bytes;
+        enforceBudget();
+    }
+
+    size_t getMemoryBudget() const {
+        return memoryBudget;
+    }
+
+    // Répertoire des instantanés des index évincés (par défaut, le répertoire temporaire)
+    void setSnapshotDirectory(const std::string& directory) {
+        snapshotDirectory = directory;
+    }
+
+    // Noms des index enregistrés
+    std::vector<std::string> getIndexNames() const {
+        std::vector<std::string> names;
+        for (const auto& item : registry) {
+            names.push_back(item.first);
+        }
+        return names;
+    }
+
+    const std::string& getCurrentName() const {
+        return currentName;
+    }
+
+    // Indique si l'index enregistré sous name est en mémoire (false s'il est évincé)
+    bool isResident(const std::string& name) const {
+        auto it = registry.find(name);
+        return it != registry.end() && it->second.isResident();
+    }
+
+    // Afficher les index enregistrés
+    void listIndexes() const {
+        if (registry.empty()) {
+            std::cout << "Aucun index n'est actuellement chargé." << std::endl;
+            return;
+        }
+        std::cout << "Index enregistrés";
+        if (memoryBudget > 0) {
+            std::cout << " (budget " << memoryBudget << " octets)";
+        }
+        std::cout << " :" << std::endl;
+        for (const auto& item : registry) {
+            const Entry& entry = item.second;
+            std::cout << (item.first == currentName ? "* " : "  ") << item.first
+                      << " [" << typeName(entry.type) << "] ";
+            if (entry.isResident()) {
+                std::cout << residentBytes(entry) << " octets";
+            } else {
+                std::cout << "évincé";
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    // Indique si un chargement est en cours (ou terminé mais pas encore adopté)
+    bool isLoading() const {
+        return pendingLoad != nullptr;
+    }
+
+    // Si le chargement en arrière-plan est terminé, remplace l'index courant par le nouvel
+    // index (l'ancien est libéré sur un autre thread). À appeler entre deux opérations.
+    // Retourne true si l'index courant a changé.
+    bool adoptPendingLoad() {
+        if (!pendingLoad || !pendingLoad->finished.load(std::memory_order_acquire)) {
+            return false;
+        }
+        if (pendingLoad->worker.joinable()) {
+            pendingLoad->worker.join();
+        }
+        std::unique_ptr<BackgroundLoad> load = std::move(pendingLoad);
+
+        if (!load->result.isResident()) {
+            std::cout << "Échec du chargement de " << load->filename
+                      << " : l'index courant est conservé." << std::endl;
+            return false;
+        }
+
+        registerIndex(load->name, load->result);
+        std::cout << "Index " << typeName(currentType) << " « " << load->name << " » chargé depuis "
+                  << load->filename;
+        if (load->snapshot) {
+            std::cout << " (instantané, " << load->progress.lines << " éléments)." << std::endl;
+        } else {
+            std::cout << " (" << load->progress.lines << " lignes, " << load->progress.errors
+                      << " erreur(s))." << std::endl;
+        }
+        return true;
+    }
+
+    // Attend la fin du chargement en cours puis l'adopte ; retourne true en cas de succès
+    bool waitForLoad() {
+        if (!pendingLoad) {
+            return false;
+        }
+        pendingLoad->worker.join();
+        return adoptPendingLoad();
+    }
+
+    // Annule le chargement en cours ; l'index courant est conservé
+    bool cancelLoad() {
+        if (!pendingLoad) {
+            return false;
+        }
+        pendingLoad->progress.cancelled = true;
+        pendingLoad->worker.join();
+        delete pendingLoad->result.charStringIndex;
+        delete pendingLoad->result.intStringIndex;
+        delete pendingLoad->result.intIntIndex;
+        pendingLoad.reset();
+        return true;
+    }
+
+    // Afficher l'avancement du chargement en cours
+    void displayLoadProgress() const {
+        if (!pendingLoad) {
+            std::cout << "Aucun chargement en cours." << std::endl;
+            return;
+        }
+        const LoadProgress& progress = pendingLoad->progress;
+        std::cout << "Chargement de " << pendingLoad->filename << " (" << typeName(pendingLoad->result.type) << ") : "
+                  << static_cast<int>(progress.percent()) << " % (" << progress.bytesRead
+                  << " / " << progress.totalBytes << " octets), " << progress.lines << " lignes, "
+                  << progress.errors << " erreur(s)";
+        if (pendingLoad->finished.load(std::memory_order_acquire)) {
+            std::cout << ", terminé";
+        }
+        std::cout << "." << std::endl;
+    }
+
     // Afficher l'index courant
     void displayCurrentIndex() const {
         if (currentType == IndexType::NONE) {
@@ -95,23 +1063,92 @@ public:
             return;
         }
 
-        std::cout << "Index de type ";
+        std::cout << "Index de type " << typeName(currentType) << " :\n";
         switch (currentType) {
             case IndexType::CHAR_STRING:
-                std::cout << "Char/String:" << std::endl << *charStringIndex << std::endl;
+                displayIndexPages(*charStringIndex);
                 break;
             case IndexType::INT_STRING:
-                std::cout << "Int/String:" << std::endl << *intStringIndex << std::endl;
+                displayIndexPages(*intStringIndex);
                 break;
             case IndexType::INT_INT:
-                std::cout << "Int/Int:" << std::endl << *intIntIndex << std::endl;
+                displayIndexPages(*intIntIndex);
                 break;
             default:
-                std::cout << "inconnu." << std::endl;
                 break;
         }
     }
 
+    // Relire un fichier dans l'index courant en n'appliquant que les différences
+    bool reloadCurrentIndex(const std::string& filename) {
+        if (currentType == IndexType::NONE) {
+            std::cout << "Aucun index n'est actuellement chargé." << std::endl;
+            return false;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        bool reloaded = false;
+        ReloadSummary<char> charSummary;
+        ReloadSummary<int> intSummary;
+        switch (currentType) {
+            case IndexType::CHAR_STRING:
+                reloaded = charStringIndex->reloadFromFile(filename, &charSummary);
+                break;
+            case IndexType::INT_STRING:
+                reloaded = intStringIndex->reloadFromFile(filename, &intSummary);
+                break;
+            case IndexType::INT_INT:
+                reloaded = intIntIndex->reloadFromFile(filename, &intSummary);
+                break;
+            default:
+                break;
+        }
+        if (!reloaded) {
+            return false;
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (currentType == IndexType::CHAR_STRING) {
+            printReloadSummary(charSummary, ms);
+        } else {
+            printReloadSummary(intSummary, ms);
+        }
+        enforceBudget();
+        return true;
+    }
+
+    // Enregistrer l'index courant au format texte, relu par les options de chargement
+    bool saveCurrentIndex(const std::string& filename) const {
+        if (currentType == IndexType::NONE) {
+            std::cout << "Aucun index n'est actuellement chargé." << std::endl;
+            return false;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        bool saved = false;
+        int count = 0;
+        switch (currentType) {
+            case IndexType::CHAR_STRING:
+                saved = charStringIndex->saveToFile(filename);
+                count = charStringIndex->getNbElements();
+                break;
+            case IndexType::INT_STRING:
+                saved = intStringIndex->saveToFile(filename);
+                count = intStringIndex->getNbElements();
+                break;
+            case IndexType::INT_INT:
+                saved = intIntIndex->saveToFile(filename);
+                count = intIntIndex->getNbElements();
+                break;
+            default:
+                break;
+        }
+        if (saved) {
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::cout << count << " élément(s) enregistré(s) dans " << filename << " (" << ms << " ms)." << std::endl;
+        }
+        return saved;
+    }
+
     // Rechercher des éléments par clé
     void searchByKey() {
         if (currentType == IndexType::NONE) {
@@ -409,24 +1446,215 @@ public:
         std::cout << "L'index de type " << type << " contient " << count << " élément(s)." << std::endl;
     }
 
+    // Afficher les statistiques de l'index courant
+    void displayStats() const {
+        if (currentType == IndexType::NONE) {
+            std::cout << "Aucun index n'est actuellement chargé." << std::endl;
+            return;
+        }
+
+        IndexStats stats;
+        std::string type;
+
+        switch (currentType) {
+            case IndexType::CHAR_STRING:
+                stats = charStringIndex->getStats();
+                type = "Char/String";
+                break;
+            case IndexType::INT_STRING:
+                stats = intStringIndex->getStats();
+                type = "Int/String";
+                break;
+            case IndexType::INT_INT:
+                stats = intIntIndex->getStats();
+                type = "Int/Int";
+                break;
+            default:
+                type = "inconnu";
+                break;
+        }
+
+        std::cout << "Statistiques de l'index de type " << type << " :\n"
+                  << "  Nœuds               : " << stats.nbNodes << "\n"
+                  << "  Éléments            : " << stats.nbElements << "\n"
+                  << "  En attente de compactage : " << stats.nbDeleted << "\n"
+                  << "  Éléments par nœud   : min " << stats.minPerNode
+                  << ", moy " << stats.avgPerNode
+                  << ", max " << stats.maxPerNode
+                  << ", p50 " << stats.p50PerNode
+                  << ", p90 " << stats.p90PerNode
+                  << ", p99 " << stats.p99PerNode << "\n"
+                  << "  Mémoire estimée     : " << stats.totalBytes() << " octets"
+                  << " (répertoire " << stats.directoryBytes
+                  << ", nœuds " << stats.nodeBytes
+                  << ", éléments " << stats.elementBytes << ")\n"
+                  << "  dont partagée       : " << stats.sharedBytes << " octets"
+                  << " (privée " << stats.privateBytes() << ")\n"
+                  << "  Durée de chargement : " << stats.loadTimeMs << " ms" << std::endl;
+    }
+
+    // Exécuter un lot de requêtes (une par ligne : "get clé", "count clé [clé_max]",
+    // "range clé_min clé_max") sur l'index courant
+    bool executeQueryBatch(const std::string& filename) {
+        if (currentType == IndexType::NONE) {
+            std::cout << "Aucun index n'est actuellement chargé." << std::endl;
+            return false;
+        }
+
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Erreur: Impossible d'ouvrir le fichier " << filename << std::endl;
+            return false;
+        }
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(file, line)) {
+            lines.push_back(line);
+        }
+
+        switch (currentType) {
+            case IndexType::CHAR_STRING:
+                runQueryBatch(*charStringIndex, lines);
+                break;
+            case IndexType::INT_STRING:
+                runQueryBatch(*intStringIndex, lines);
+                break;
+            case IndexType::INT_INT:
+                runQueryBatch(*intIntIndex, lines);
+                break;
+            default:
+                std::cout << "Type d'index inconnu." << std::endl;
+                return false;
+        }
+        return true;
+    }
+
+    // Mode batch : exécute les commandes lues dans in, une par ligne, sans invite, et écrit
+    // les résultats dans out (tampon d'écriture unique, vidé à la fin).
+    // Commandes :
+    //   load cs|is|ii <fichier> [nom]   charge un index (Char/String, Int/String, Int/Int) et l'active
+    //   loadsnap cs|is|ii <fichier> [nom]
+    //                                    de même depuis un instantané binaire (save, buildSnapshot)
+    //   use <nom>                        active un index chargé
+    //   get <clé>                        éléments de la clé
+    //   range <clé_min> <clé_max>        éléments de clé dans l'intervalle
+    //   count [<clé_min> [<clé_max>]]    nombre d'éléments (de l'index, d'une clé ou d'un intervalle)
+    //   query <fichier>                  exécute en parallèle les get, count et range du fichier
+    //                                    (résultat : nombre de requêtes, suivi de leurs sorties)
+    //   add <clé> <valeur>               ajoute un élément
+    //   del <clé> <valeur>               supprime un élément
+    //   delnode <clé>                    supprime un nœud
+    //   save <fichier>                   écrit un instantané binaire de l'index courant
+    //   export <fichier>                 écrit l'index courant au format texte "clé ; valeur"
+    //   reload <fichier>                 relit un fichier en n'appliquant que ses différences
+    //                                    (résultat : éléments ajoutés et supprimés)
+    // Les lignes vides et les commentaires (#) sont ignorés.
+    // Chaque commande produit une ligne "statut<TAB>commande<TAB>résultat", le statut étant
+    // ok, notfound ou error (le résultat est alors le message d'erreur) ; avec timing, la
+    // durée d'exécution en microsecondes suit dans un quatrième champ. get et range sont
+    // suivis d'une ligne "clé<TAB>valeur" par élément de la page [offset, offset + limit),
+    // le résultat en donnant le nombre.
+    // Retourne le nombre de commandes en erreur.
+    int runBatch(std::istream& in, std::ostream& out, const BatchOptions& options = BatchOptions()) {
+        BufferedWriter writer(out);
+        BatchCommand command;
+        command.options = options;
+        std::string line;
+        int errors = 0;
+
+        while (std::getline(in, line)) {
+            ++command.line;
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            std::istringstream iss(line);
+            if (!(iss >> command.name) || command.name[0] == '#') {
+                continue;
+            }
+            command.start = std::chrono::steady_clock::now();
+            command.fields.clear();
+            for (std::string field; iss >> field;) {
+                command.fields.push_back(field);
+            }
+            // Texte après le premier champ, espaces internes conservés
+            command.rest.clear();
+            std::istringstream restStream(line);
+            std::string skipped;
+            restStream >> skipped >> skipped >> std::ws;
+            std::getline(restStream, command.rest);
+            command.rest.erase(command.rest.find_last_not_of(" \t") + 1);
+
+            bool ok = true;
+            if (command.name == "load" || command.name == "loadsnap") {
+                ok = runBatchLoad(command, writer);
+            } else if (command.name == "use") {
+                ok = command.fields.size() == 1 && activateIndex(command.fields[0]);
+                if (ok) {
+                    writeStatus(writer, "ok", command, currentElementCount());
+                } else {
+                    writeStatus(writer, "notfound", command, 0);
+                }
+            } else {
+                switch (currentType) {
+                    case IndexType::CHAR_STRING:
+                        ok = runBatchCommand(*charStringIndex, command, writer);
+                        break;
+                    case IndexType::INT_STRING:
+                        ok = runBatchCommand(*intStringIndex, command, writer);
+                        break;
+                    case IndexType::INT_INT:
+                        ok = runBatchCommand(*intIntIndex, command, writer);
+                        break;
+                    default:
+                        writeError(writer, command, "aucun index chargé");
+                        ok = false;
+                        break;
+                }
+            }
+            errors += ok ? 0 : 1;
+        }
+        return errors;
+    }
+
     // Vérifier si un index est chargé
     bool isIndexLoaded() const {
         return currentType != IndexType::NONE;
     }
 
-    // Méthode utilitaire pour afficher les éléments
-    template <typename T>
-    void displayElements(const std::vector<T>& elements) const {
+    // Méthode utilitaire pour afficher les éléments, numérotés, par pages de pageSize
+    template <typename K, typename V>
+    void displayElements(const std::vector<Element<K, V>*>& elements) const {
         if (elements.empty()) {
             std::cout << "Aucun élément trouvé." << std::endl;
             return;
         }
 
-        std::cout << "Éléments trouvés (" << elements.size() << ") :" << std::endl;
+        BufferedWriter out(std::cout);
+        out << "Éléments trouvés (" << elements.size() << ") :\n";
+        std::string line;
         for (size_t i = 0; i < elements.size(); ++i) {
-            std::cout << (i + 1) << ". " << *elements[i] << std::endl;
+            if (pageSize > 0 && i > 0 && i % pageSize == 0) {
+                out.flush();
+                if (!askForMore(elements.size() - i)) {
+                    break;
+                }
+            }
+            line.clear();
+            appendText(line, i + 1);
+            line += ". ";
+            formatElement(*elements[i], ResultFormat::TEXT, line);
+            out.write(line);
         }
     }
+
+    // Éléments par page des affichages interactifs (0 : tout afficher d'un bloc)
+    void setPageSize(size_t size) {
+        pageSize = size;
+    }
+
+    size_t getPageSize() const {
+        return pageSize;
+    }
 };
 
 #endif // INDEX_MANAGER_H
\ No newline at end of file
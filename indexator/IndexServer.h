@@ -0,0 +1,541 @@
+#ifndef INDEX_SERVER_H
+#define INDEX_SERVER_H
+
+#ifndef __linux__
+#error "IndexServer nécessite Linux (epoll)"
+#endif
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "Element.h"
+#include "Index.h"
+#include "Serialization.h"
+#include "Protocol.h"
+
+// Index servi par IndexServer, quel que soit son type : décode les arguments d'une requête,
+// l'exécute et code la réponse.
+class ServedIndex {
+public:
+    virtual ~ServedIndex() {}
+
+    // Exécute la requête dont les arguments sont dans request et écrit le corps de la
+    // réponse dans response. Retourne le statut, ERROR si les arguments sont mal formés.
+    virtual ResponseStatus handle(Opcode opcode, FrameReader& request, FrameWriter& response) = 0;
+};
+
+template <typename K, typename V>
+class TypedServedIndex : public ServedIndex {
+public:
+    Index<K, V> index;
+
+    ResponseStatus handle(Opcode opcode, FrameReader& request, FrameWriter& response) override {
+        K key, hi;
+        V value;
+        switch (opcode) {
+            case Opcode::GET:
+                if (!request.get(key) || !request.atEnd()) {
+                    return ResponseStatus::ERROR;
+                }
+                putValues(index.getElements(key), response);
+                return ResponseStatus::OK;
+
+            case Opcode::MULTI_GET: {
+                uint32_t nbKeys;
+                if (!request.get(nbKeys)) {
+                    return ResponseStatus::ERROR;
+                }
+                for (uint32_t i = 0; i < nbKeys; ++i) {
+                    if (!request.get(key)) {
+                        return ResponseStatus::ERROR;
+                    }
+                    putValues(index.getElements(key), response);
+                }
+                return request.atEnd() ? ResponseStatus::OK : ResponseStatus::ERROR;
+            }
+
+            case Opcode::RANGE: {
+                if (!request.get(key) || !request.get(hi) || !request.atEnd()) {
+                    return ResponseStatus::ERROR;
+                }
+                return putRange(key, hi, response);
+            }
+
+            case Opcode::ADD:
+                if (!request.get(key) || !request.get(value) || !request.atEnd()) {
+                    return ResponseStatus::ERROR;
+                }
+                index.addElement(new Element<K, V>(key, value));
+                return ResponseStatus::OK;
+
+            case Opcode::DELETE: {
+                if (!request.get(key) || !request.get(value) || !request.atEnd()) {
+                    return ResponseStatus::ERROR;
+                }
+                Element<K, V> target(key, value);
+                return index.deleteElement(&target) ? ResponseStatus::OK : ResponseStatus::NOT_FOUND;
+            }
+
+            case Opcode::DELETE_NODE:
+                if (!request.get(key) || !request.atEnd()) {
+                    return ResponseStatus::ERROR;
+                }
+                return index.deleteNode(key) ? ResponseStatus::OK : ResponseStatus::NOT_FOUND;
+
+            case Opcode::COUNT:
+                if (!request.get(key) || !request.get(hi) || !request.atEnd()) {
+                    return ResponseStatus::ERROR;
+                }
+                response.put(static_cast<uint32_t>(index.countRange(key, hi)));
+                return ResponseStatus::OK;
+
+            case Opcode::STATS: {
+                if (!request.atEnd()) {
+                    return ResponseStatus::ERROR;
+                }
+                IndexStats stats = index.getStats();
+                response.put(BinaryTag<K>::value);
+                response.put(BinaryTag<V>::value);
+                response.put(static_cast<uint32_t>(stats.nbNodes));
+                response.put(static_cast<uint32_t>(stats.nbElements));
+                response.put(static_cast<uint64_t>(stats.totalBytes()));
+                return ResponseStatus::OK;
+            }
+        }
+        return ResponseStatus::ERROR;
+    }
+
+private:
+    // Paires de [lo, hi], nœud par nœud, jusqu'à MaxRangeReply octets : la réponse reste
+    // bornée quelle que soit la taille de l'intervalle
+    ResponseStatus putRange(const K& lo, const K& hi, FrameWriter& response) const {
+        size_t countPosition = response.reserve<uint32_t>();
+        size_t start = response.written();
+        uint32_t count = 0;
+        std::vector<Element<K, V>*> node;
+        size_t position = index.scanRange(lo, hi, 0, 1, node);
+        while (true) {
+            for (const auto* element : node) {
+                response.put(element->getKey());
+                response.put(element->getValue());
+            }
+            count += static_cast<uint32_t>(node.size());
+            node.clear();
+            if (position == Index<K, V>::ScanEnd) {
+                response.set(countPosition, count);
+                return ResponseStatus::OK;
+            }
+            bool full = response.written() - start >= MaxRangeReply;
+            position = index.scanRange(lo, hi, position, 1, node);
+            if (full && !node.empty()) {
+                response.set(countPosition, count);
+                response.put(node.front()->getKey());
+                return ResponseStatus::PARTIAL;
+            }
+        }
+    }
+
+    static void putValues(const std::vector<Element<K, V>*>& elements, FrameWriter& response) {
+        response.put(static_cast<uint32_t>(elements.size()));
+        for (const auto* element : elements) {
+            response.put(element->getValue());
+        }
+    }
+};
+
+// Serveur d'index local : sert des index nommés sur une socket Unix et/ou en TCP sur
+// 127.0.0.1, avec le protocole de Protocol.h.
+// Une seule boucle epoll traite toutes les connexions : les requêtes reçues d'un bloc sont
+// exécutées à la suite et leurs réponses envoyées ensemble (pipelining). Les index ne sont
+// touchés que par cette boucle et n'ont donc pas besoin de verrous.
+// Une connexion dont les réponses en attente dépassent MaxPendingOutput n'est plus lue
+// jusqu'à ce que le client les ait reçues.
+class IndexServer {
+public:
+    static constexpr size_t MaxPendingOutput = 4u << 20;
+
+    IndexServer() {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        watch(stopFd, EPOLLIN);
+    }
+
+    ~IndexServer() {
+        for (auto& entry : connections) {
+            close(entry.first);
+        }
+        for (int fd : listeners) {
+            close(fd);
+        }
+        if (!unixPath.empty()) {
+            unlink(unixPath.c_str());
+        }
+        close(stopFd);
+        close(epollFd);
+    }
+
+    IndexServer(const IndexServer&) = delete;
+    IndexServer& operator=(const IndexServer&) = delete;
+
+    // Ajoute un index vide sous le nom name (remplace l'index de même nom) et le retourne,
+    // à remplir avant run()
+    template <typename K, typename V>
+    Index<K, V>& addIndex(const std::string& name) {
+        auto served = std::make_unique<TypedServedIndex<K, V>>();
+        Index<K, V>& index = served->index;
+        indexes[name] = std::move(served);
+        return index;
+    }
+
+    // Écoute sur la socket Unix path (un fichier existant à ce chemin est remplacé)
+    bool listenUnix(const std::string& path) {
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path)) {
+            std::cerr << "Erreur: Chemin de socket trop long: " << path << std::endl;
+            return false;
+        }
+        address.sun_family = AF_UNIX;
+        std::strcpy(address.sun_path, path.c_str());
+        unlink(path.c_str());
+
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0 || bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0) {
+            std::cerr << "Erreur: Impossible d'écouter sur " << path << ": " << std::strerror(errno) << std::endl;
+            if (fd >= 0) {
+                close(fd);
+            }
+            return false;
+        }
+        unixPath = path;
+        addListener(fd);
+        return true;
+    }
+
+    // Écoute en TCP sur 127.0.0.1:port (port 0 : port libre choisi par le système, voir getTcpPort)
+    bool listenTcp(uint16_t port) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+
+        int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int reuse = 1;
+        if (fd < 0 || setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0
+            || bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0) {
+            std::cerr << "Erreur: Impossible d'écouter sur le port " << port << ": " << std::strerror(errno) << std::endl;
+            if (fd >= 0) {
+                close(fd);
+            }
+            return false;
+        }
+        socklen_t length = sizeof(address);
+        getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+        tcpPort = ntohs(address.sin_port);
+        addListener(fd);
+        return true;
+    }
+
+    uint16_t getTcpPort() const {
+        return tcpPort;
+    }
+
+    // Boucle d'événements : retourne après stop()
+    void run() {
+        std::vector<epoll_event> events(256);
+        while (!stopping.load(std::memory_order_acquire)) {
+            int ready = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), -1);
+            if (ready < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "Erreur: epoll_wait: " << std::strerror(errno) << std::endl;
+                return;
+            }
+            for (int i = 0; i < ready; ++i) {
+                int fd = events[i].data.fd;
+                if (fd == stopFd) {
+                    continue;
+                }
+                if (isListener(fd)) {
+                    acceptAll(fd);
+                    continue;
+                }
+                auto it = connections.find(fd);
+                if (it != connections.end()) {
+                    serve(*it->second, events[i].events);
+                }
+            }
+        }
+    }
+
+    // Arrête run() ; appelable depuis un autre thread
+    void stop() {
+        stopping.store(true, std::memory_order_release);
+        uint64_t one = 1;
+        ssize_t written = write(stopFd, &one, sizeof(one));
+        (void)written;
+    }
+
+private:
+    struct Connection {
+        int fd = -1;
+        uint32_t events = 0;        // Événements surveillés
+        std::string input;          // Octets reçus pas encore traités, à partir de inputOffset
+        size_t inputOffset = 0;
+        std::string output;         // Réponses pas encore envoyées, à partir de outputOffset
+        size_t outputOffset = 0;
+        bool closing = false;       // Fermer après l'envoi des réponses en attente
+    };
+
+    int epollFd = -1;
+    int stopFd = -1;
+    std::atomic<bool> stopping{false};
+    std::vector<int> listeners;
+    std::string unixPath;
+    uint16_t tcpPort = 0;
+    std::map<std::string, std::unique_ptr<ServedIndex>> indexes;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+
+    void watch(int fd, uint32_t events) {
+        epoll_event event{};
+        event.events = events;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+
+    void addListener(int fd) {
+        listeners.push_back(fd);
+        watch(fd, EPOLLIN);
+    }
+
+    bool isListener(int fd) const {
+        return std::find(listeners.begin(), listeners.end(), fd) != listeners.end();
+    }
+
+    void acceptAll(int listener) {
+        while (true) {
+            int fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                return;   // EAGAIN : plus de connexion en attente
+            }
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));   // Sans effet en Unix
+            auto connection = std::make_unique<Connection>();
+            connection->fd = fd;
+            connection->events = EPOLLIN;
+            watch(fd, EPOLLIN);
+            connections[fd] = std::move(connection);
+        }
+    }
+
+    void closeConnection(Connection& connection) {
+        int fd = connection.fd;
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+    }
+
+    void serve(Connection& connection, uint32_t events) {
+        if (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+            if (!receive(connection)) {
+                connection.closing = true;
+            }
+        }
+        // Exécute les requêtes reçues et envoie les réponses, tant que l'envoi ne bloque pas
+        bool more = true;
+        while (more) {
+            more = processInput(connection);
+            if (!flush(connection)) {
+                closeConnection(connection);
+                return;
+            }
+            more = more && connection.output.empty();
+        }
+        if (connection.closing && connection.output.empty()) {
+            closeConnection(connection);
+            return;
+        }
+        updateEvents(connection);
+    }
+
+    // Vrai si l'entrée en attente commence par une trame complète (ou de taille invalide)
+    static bool hasCompleteFrame(const Connection& connection) {
+        size_t pending = connection.input.size() - connection.inputOffset;
+        if (pending < FrameHeaderSize) {
+            return false;
+        }
+        uint32_t size = frameSize(connection.input.data() + connection.inputOffset);
+        return size > MaxFrameSize || pending - FrameHeaderSize >= size;
+    }
+
+    // Lit ce qui est disponible, jusqu'à disposer d'une trame complète : l'entrée en attente
+    // ne dépasse pas une trame plus une lecture, le reste attend dans la socket (epoll le
+    // signale de nouveau). false si le client a fermé ou en cas d'erreur.
+    bool receive(Connection& connection) {
+        if (connection.output.size() - connection.outputOffset >= MaxPendingOutput
+            || hasCompleteFrame(connection)) {
+            return true;
+        }
+        char buffer[65536];
+        while (true) {
+            ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+            if (received > 0) {
+                connection.input.append(buffer, static_cast<size_t>(received));
+                if (hasCompleteFrame(connection)) {
+                    return true;
+                }
+                continue;
+            }
+            if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                return true;
+            }
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+    }
+
+    // Exécute les requêtes complètes reçues, tant que les réponses en attente ne dépassent
+    // pas MaxPendingOutput. Retourne true s'il reste des requêtes arrêtées par cette limite.
+    bool processInput(Connection& connection) {
+        std::string& input = connection.input;
+        size_t& offset = connection.inputOffset;
+        while (input.size() - offset >= FrameHeaderSize
+               && connection.output.size() - connection.outputOffset < MaxPendingOutput) {
+            uint32_t size = frameSize(input.data() + offset);
+            if (size > MaxFrameSize) {
+                connection.closing = true;   // Trame invalide : flux désynchronisé
+                input.clear();
+                offset = 0;
+                return false;
+            }
+            if (input.size() - offset - FrameHeaderSize < size) {
+                break;   // Trame incomplète
+            }
+            FrameReader request(input.data() + offset + FrameHeaderSize, size);
+            handle(request, connection.output);
+            offset += FrameHeaderSize + size;
+        }
+        bool blocked = connection.output.size() - connection.outputOffset >= MaxPendingOutput;
+        if (offset == input.size()) {
+            input.clear();
+            offset = 0;
+        } else if (offset > input.size() / 2) {
+            input.erase(0, offset);
+            offset = 0;
+        }
+        return blocked && input.size() - offset >= FrameHeaderSize;
+    }
+
+    // Exécute une requête et ajoute sa réponse à output
+    void handle(FrameReader& request, std::string& output) {
+        FrameWriter response(output);
+        response.begin();
+        uint8_t opcode = 0;
+        uint32_t id = 0;
+        std::string name;
+        if (!request.get(opcode) || !request.get(id) || !request.get(name)) {
+            putError(response, id, "Requête mal formée");
+            return;
+        }
+        auto it = indexes.find(name);
+        if (it == indexes.end()) {
+            putError(response, id, "Index inconnu: " + name);
+            return;
+        }
+        if (opcode < static_cast<uint8_t>(Opcode::GET) || opcode > static_cast<uint8_t>(Opcode::STATS)) {
+            putError(response, id, "Opération inconnue");
+            return;
+        }
+
+        size_t statusPosition = response.reserve<uint8_t>();
+        response.put(id);
+        ResponseStatus status = it->second->handle(static_cast<Opcode>(opcode), request, response);
+        if (status == ResponseStatus::ERROR) {
+            putError(response, id, "Arguments invalides");
+            return;
+        }
+        if (status == ResponseStatus::OK || status == ResponseStatus::PARTIAL) {
+            response.set(statusPosition, static_cast<uint8_t>(status));
+        } else {
+            response.cancel();
+            response.begin();
+            response.put(static_cast<uint8_t>(status));
+            response.put(id);
+        }
+        response.end();
+    }
+
+    // Remplace la réponse commencée par une erreur
+    static void putError(FrameWriter& response, uint32_t id, const std::string& message) {
+        response.cancel();
+        response.begin();
+        response.put(static_cast<uint8_t>(ResponseStatus::ERROR));
+        response.put(id);
+        response.put(message);
+        response.end();
+    }
+
+    // Envoie les réponses en attente ; false en cas d'erreur d'envoi
+    bool flush(Connection& connection) {
+        std::string& output = connection.output;
+        while (connection.outputOffset < output.size()) {
+            ssize_t sent = send(connection.fd, output.data() + connection.outputOffset,
+                                output.size() - connection.outputOffset, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            connection.outputOffset += static_cast<size_t>(sent);
+            if (connection.outputOffset > output.size() / 2 && connection.outputOffset < output.size()) {
+                output.erase(0, connection.outputOffset);
+                connection.outputOffset = 0;
+            }
+        }
+        output.clear();
+        connection.outputOffset = 0;
+        return true;
+    }
+
+    // Surveille la lecture tant que les réponses en attente le permettent, l'écriture tant
+    // qu'il en reste
+    void updateEvents(Connection& connection) {
+        size_t pending = connection.output.size() - connection.outputOffset;
+        uint32_t events = 0;
+        if (pending < MaxPendingOutput && !connection.closing) {
+            events |= EPOLLIN;
+        }
+        if (pending > 0) {
+            events |= EPOLLOUT;
+        }
+        if (events != connection.events) {
+            epoll_event event{};
+            event.events = events;
+            event.data.fd = connection.fd;
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+            connection.events = events;
+        }
+    }
+};
+
+#endif // INDEX_SERVER_H
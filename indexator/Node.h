@@ -4,18 +4,65 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <stdexcept>
+#include <string>
 #include "Element.h"
 
+// Estimation de la mémoire allouée sur le tas par une valeur (hors sizeof)
+template <typename T>
+size_t heapBytes(const T&) {
+    return 0;
+}
+
+inline size_t heapBytes(const std::string& str) {
+    // Les chaînes courtes sont stockées dans l'objet lui-même (SSO)
+    return str.capacity() > 15 ? str.capacity() + 1 : 0;
+}
+
 template <typename K, typename V>
 class Node {
 private:
     K key;                              // Clé de recherche du nœud
     std::vector<Element<K, V>*> elements; // Collection d'éléments du nœud
+    std::vector<bool> tombstones;         // Éléments marqués supprimés (vide si aucun)
+    int deadCount = 0;                    // Nombre d'éléments marqués supprimés
+
+    // Ordre des éléments dans le nœud : par valeur
+    static bool valueLess(const Element<K, V>* a, const Element<K, V>* b) {
+        return a->getValue() < b->getValue();
+    }
+
+    bool isDead(size_t i) const {
+        return deadCount > 0 && tombstones[i];
+    }
+
+    // Premier élément vivant égal à element (les éléments sont triés par valeur)
+    typename std::vector<Element<K, V>*>::iterator findLive(const Element<K, V>* element) {
+        auto range = std::equal_range(elements.begin(), elements.end(), element, valueLess);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (!isDead(it - elements.begin()) && **it == *element) {
+                return it;
+            }
+        }
+        return elements.end();
+    }
 
 public:
     // Constructeur
     Node(const K& k) : key(k) {}
 
+    // Copie profonde des éléments vivants (copie sur écriture d'un nœud partagé)
+    Node(const Node<K, V>& other) : key(other.key) {
+        elements.reserve(other.getNbElements());
+        for (size_t i = 0; i < other.elements.size(); ++i) {
+            if (!other.isDead(i)) {
+                elements.push_back(new Element<K, V>(*other.elements[i]));
+            }
+        }
+    }
+
+    Node& operator=(const Node&) = delete;
+
     // Destructeur - libère la mémoire allouée pour les éléments
     ~Node() {
         for (auto element : elements) {
@@ -27,11 +74,50 @@ public:
     // Accesseurs
     const K& getKey() const { return key; }
 
-    int getNbElements() const { return elements.size(); }
+    // Nombre d'éléments vivants (les éléments marqués supprimés ne sont pas comptés)
+    int getNbElements() const { return elements.size() - deadCount; }
+
+    // Nombre d'éléments marqués supprimés en attente de compactage
+    int getNbDeleted() const { return deadCount; }
 
     // Retourne tous les éléments du nœud
     std::vector<Element<K, V>*> getAllElements() const {
-        return elements;
+        if (deadCount == 0) {
+            return elements;
+        }
+        std::vector<Element<K, V>*> live;
+        live.reserve(getNbElements());
+        collectElements(live);
+        return live;
+    }
+
+    // Ajoute les éléments du nœud à la fin de out (sans allocation si out a déjà la capacité)
+    void collectElements(std::vector<Element<K, V>*>& out) const {
+        if (deadCount == 0) {
+            out.insert(out.end(), elements.begin(), elements.end());
+            return;
+        }
+        for (size_t i = 0; i < elements.size(); ++i) {
+            if (!tombstones[i]) {
+                out.push_back(elements[i]);
+            }
+        }
+    }
+
+    // Nombre d'emplacements du tableau d'éléments, éléments marqués supprimés compris
+    size_t getNbSlots() const { return elements.size(); }
+
+    // Ajoute à out au plus max éléments vivants à partir de l'emplacement from et retourne
+    // l'emplacement suivant (getNbSlots() une fois le nœud épuisé)
+    size_t collectElements(size_t from, size_t max, std::vector<Element<K, V>*>& out) const {
+        size_t i = from;
+        for (; i < elements.size() && max > 0; ++i) {
+            if (!isDead(i)) {
+                out.push_back(elements[i]);
+                --max;
+            }
+        }
+        return i;
     }
 
     // Retourne les éléments dont la clé correspond à k
@@ -41,7 +127,29 @@ public:
         if (k != key) {
             return std::vector<Element<K, V>*>();
         }
-        return elements;
+        return getAllElements();
+    }
+
+    // Indique si un élément vivant égal à element est présent
+    bool containsElement(const Element<K, V>& element) const {
+        auto range = std::equal_range(elements.begin(), elements.end(), &element, valueLess);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (!isDead(it - elements.begin()) && **it == element) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Indique si un élément vivant vérifie pred
+    template <typename Predicate>
+    bool anyElement(Predicate pred) const {
+        for (size_t i = 0; i < elements.size(); ++i) {
+            if (!isDead(i) && pred(static_cast<const Element<K, V>&>(*elements[i]))) {
+                return true;
+            }
+        }
+        return false;
     }
 
     // Ajoute un élément au nœud
@@ -51,26 +159,39 @@ public:
             throw std::invalid_argument("La clé de l'élément ne correspond pas à celle du nœud");
         }
 
-        // Ajouter l'élément
-        elements.push_back(element);
+        // Insérer l'élément à sa place pour garder les éléments triés par valeur
+        auto pos = std::upper_bound(elements.begin(), elements.end(), element, valueLess);
+        if (!tombstones.empty()) {
+            tombstones.insert(tombstones.begin() + (pos - elements.begin()), false);
+        }
+        elements.insert(pos, element);
+    }
+
+    // Fusionne une séquence d'éléments déjà triés par valeur en un seul passage linéaire
+    template <typename It>
+    void mergeElements(It first, It last) {
+        for (It it = first; it != last; ++it) {
+            if ((*it)->getKey() != key) {
+                throw std::invalid_argument("La clé de l'élément ne correspond pas à celle du nœud");
+            }
+        }
 
-        // Trier les éléments par valeur
-        std::sort(elements.begin(), elements.end(),
-            [](const Element<K, V>* a, const Element<K, V>* b) {
-                return a->getValue() < b->getValue();
-            });
+        compact();
+        size_t middle = elements.size();
+        elements.insert(elements.end(), first, last);
+        std::inplace_merge(elements.begin(), elements.begin() + middle, elements.end(), valueLess);
     }
 
     // Supprime un élément du nœud
     bool deleteElement(Element<K, V>* element) {
         // Rechercher l'élément
-        auto it = std::find_if(elements.begin(), elements.end(),
-            [element](const Element<K, V>* e) {
-                return *e == *element;
-            });
+        auto it = findLive(element);
 
         // Si l'élément est trouvé, le supprimer
         if (it != elements.end()) {
+            if (!tombstones.empty()) {
+                tombstones.erase(tombstones.begin() + (it - elements.begin()));
+            }
             delete *it;           // Libérer la mémoire
             elements.erase(it);   // Retirer de la collection
             return true;
@@ -79,6 +200,76 @@ public:
         return false;  // Élément non trouvé
     }
 
+    // Suppression paresseuse : marque l'élément sans déplacer le tableau.
+    // La mémoire est libérée au prochain compact().
+    bool markDeleted(Element<K, V>* element) {
+        auto it = findLive(element);
+        if (it == elements.end()) {
+            return false;
+        }
+
+        if (tombstones.empty()) {
+            tombstones.assign(elements.size(), false);
+        }
+        tombstones[it - elements.begin()] = true;
+        ++deadCount;
+        return true;
+    }
+
+    // Marque tous les éléments du nœud comme supprimés
+    void markAllDeleted() {
+        tombstones.assign(elements.size(), true);
+        deadCount = elements.size();
+    }
+
+    // Libère les éléments marqués et compacte le tableau en un seul passage
+    void compact() {
+        if (deadCount == 0) {
+            return;
+        }
+        removeIf([](const Element<K, V>&) { return false; });
+    }
+
+    // Supprime en un seul passage stable les éléments pour lesquels pred est vrai.
+    // Retourne le nombre d'éléments supprimés.
+    template <typename Predicate>
+    int removeIf(Predicate pred) {
+        // Les éléments marqués supprimés sont libérés dans le même passage
+        int removed = 0;
+        auto kept = elements.begin();
+        for (auto it = elements.begin(); it != elements.end(); ++it) {
+            if (isDead(it - elements.begin())) {
+                delete *it;
+            } else if (pred(static_cast<const Element<K, V>&>(**it))) {
+                delete *it;
+                ++removed;
+            } else {
+                *kept++ = *it;
+            }
+        }
+
+        elements.erase(kept, elements.end());
+        tombstones.clear();
+        deadCount = 0;
+        return removed;
+    }
+
+    // Estimation de la mémoire du nœud lui-même et de ses tableaux
+    size_t estimateNodeBytes() const {
+        return sizeof(*this) + heapBytes(key)
+               + elements.capacity() * sizeof(Element<K, V>*)
+               + tombstones.capacity() / 8;
+    }
+
+    // Estimation de la mémoire des éléments du nœud (clés et valeurs comprises)
+    size_t estimateElementBytes() const {
+        size_t bytes = elements.size() * sizeof(Element<K, V>);
+        for (const auto* element : elements) {
+            bytes += heapBytes(element->getKey()) + heapBytes(element->getValue());
+        }
+        return bytes;
+    }
+
     // Opérateur de comparaison pour trier les nœuds
     bool operator<(const Node<K, V>& other) const {
         return key < other.key;
@@ -86,10 +277,13 @@ public:
 
     // Affichage (pour débogage)
     friend std::ostream& operator<<(std::ostream& os, const Node<K, V>& node) {
-        os << "Node[key=" << node.key << ", elements=" << node.elements.size() << "]{";
+        os << "Node[key=" << node.key << ", elements=" << node.getNbElements() << "]{";
+        bool first = true;
         for (size_t i = 0; i < node.elements.size(); ++i) {
-            if (i > 0) os << ", ";
+            if (node.isDead(i)) continue;
+            if (!first) os << ", ";
             os << *node.elements[i];
+            first = false;
         }
         os << "}";
         return os;
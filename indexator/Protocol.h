@@ -0,0 +1,143 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include "Serialization.h"
+
+// Protocole binaire du serveur d'index (voir IndexServer et IndexClient).
+// Chaque message est une trame : taille de la charge utile (u32) puis la charge utile.
+//   requête : opcode (u8), identifiant (u32), nom de l'index, arguments
+//   réponse : statut (u8), identifiant de la requête (u32), corps
+// Les entiers et les caractères sont écrits tels quels, dans l'ordre d'octets de la machine
+// (le serveur n'écoute qu'en local) ; les chaînes sont préfixées par leur longueur sur 32 bits.
+// Les clés et valeurs sont codées selon le type de l'index, donné par STATS.
+// Un client peut envoyer plusieurs requêtes sans attendre : les réponses arrivent dans
+// l'ordre des requêtes.
+enum class Opcode : uint8_t {
+    GET = 1,           // clé                 -> n (u32), n valeurs
+    MULTI_GET = 2,     // n (u32), n clés     -> pour chaque clé : m (u32), m valeurs
+    RANGE = 3,         // clé_min, clé_max    -> n (u32), n paires (clé, valeur) ; au-delà de
+                       //                        MaxRangeReply, PARTIAL (voir ResponseStatus)
+    ADD = 4,           // clé, valeur         -> (vide)
+    DELETE = 5,        // clé, valeur         -> (vide), NOT_FOUND si absent
+    DELETE_NODE = 6,   // clé                 -> (vide), NOT_FOUND si absent
+    COUNT = 7,         // clé_min, clé_max    -> n (u32)
+    STATS = 8          // (aucun)             -> types clé et valeur (u8, voir BinaryTag),
+                       //                        nœuds (u32), éléments (u32), octets (u64)
+};
+
+enum class ResponseStatus : uint8_t {
+    OK = 0,
+    NOT_FOUND = 1,
+    ERROR = 2,         // corps : message d'erreur
+    PARTIAL = 3        // RANGE tronqué : corps de OK pour des nœuds entiers, suivi de la clé
+                       // du premier nœud omis, d'où reprendre l'intervalle
+};
+
+const uint32_t MaxFrameSize = 16u << 20;   // Taille maximale d'une charge utile
+const size_t MaxRangeReply = 1u << 20;     // Octets de paires d'une réponse RANGE (dépassé d'un nœud au plus)
+const size_t FrameHeaderSize = sizeof(uint32_t);
+
+// Construit des trames à la suite dans un tampon
+class FrameWriter {
+public:
+    explicit FrameWriter(std::string& buffer) : buffer(buffer) {}
+
+    // Commence une trame : sa taille est écrite par end()
+    void begin() {
+        frameStart = buffer.size();
+        buffer.append(FrameHeaderSize, '\0');
+    }
+
+    void end() {
+        uint32_t size = static_cast<uint32_t>(buffer.size() - frameStart - FrameHeaderSize);
+        std::memcpy(&buffer[frameStart], &size, sizeof(size));
+    }
+
+    // Octets écrits dans la trame commencée, taille comprise
+    size_t written() const {
+        return buffer.size() - frameStart;
+    }
+
+    // Réserve la place d'une valeur écrite plus tard par set() et retourne sa position
+    template <typename T>
+    size_t reserve() {
+        buffer.append(sizeof(T), '\0');
+        return buffer.size() - sizeof(T);
+    }
+
+    template <typename T>
+    void set(size_t position, const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Type non sérialisable");
+        std::memcpy(&buffer[position], &value, sizeof(T));
+    }
+
+    // Annule la trame commencée
+    void cancel() {
+        buffer.resize(frameStart);
+    }
+
+    template <typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Type non sérialisable");
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void put(const std::string& value) {
+        put(static_cast<uint32_t>(value.size()));
+        buffer.append(value);
+    }
+
+private:
+    std::string& buffer;
+    size_t frameStart = 0;
+};
+
+// Lit la charge utile d'une trame. Les lectures échouent (false) au-delà de la fin.
+class FrameReader {
+public:
+    FrameReader(const char* data, size_t size) : data(data), size(size) {}
+
+    template <typename T>
+    bool get(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Type non sérialisable");
+        if (size - position < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+
+    bool get(std::string& value) {
+        uint32_t length;
+        if (!get(length) || size - position < length) {
+            return false;
+        }
+        value.assign(data + position, length);
+        position += length;
+        return true;
+    }
+
+    // Indique si toute la charge utile a été lue
+    bool atEnd() const {
+        return position == size;
+    }
+
+private:
+    const char* data;
+    size_t size;
+    size_t position = 0;
+};
+
+// Taille de la charge utile de la trame qui commence en data (au moins FrameHeaderSize octets)
+inline uint32_t frameSize(const char* data) {
+    uint32_t size;
+    std::memcpy(&size, data, sizeof(size));
+    return size;
+}
+
+#endif // PROTOCOL_H
@@ -0,0 +1,131 @@
+#ifndef QUERY_EXECUTOR_H
+#define QUERY_EXECUTOR_H
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include "Element.h"
+#include "Index.h"
+#include "ThreadPool.h"
+
+// Requête de lecture d'un lot
+template <typename K>
+struct Query {
+    enum class Type {
+        GET,     // Éléments de la clé lo
+        COUNT,   // Nombre d'éléments de clé dans [lo, hi]
+        RANGE    // Éléments de clé dans [lo, hi]
+    };
+
+    Type type = Type::GET;
+    K lo{};
+    K hi{};
+};
+
+// Résultat d'une requête : éléments (GET, RANGE) et leur nombre
+template <typename K, typename V>
+struct QueryResult {
+    std::vector<const Element<K, V>*> elements;
+    int count = 0;
+};
+
+// Résultats d'un lot, dans l'ordre de soumission. Les éléments pointés appartiennent à
+// l'instantané view, conservé avec les résultats.
+template <typename K, typename V>
+struct BatchResult {
+    std::shared_ptr<const Index<K, V>> view;
+    std::vector<QueryResult<K, V>> results;
+    double latencyMs = 0.0;   // Durée du lot, de la soumission au dernier résultat
+};
+
+// Exécute des lots de requêtes en parallèle sur une réserve de threads.
+// Le lot est découpé en tranches de requêtes consécutives, exécutées sur un instantané de
+// l'index : toutes les requêtes voient la même version, même si l'index évolue pendant
+// l'exécution. Chaque tranche écrit dans ses propres emplacements de résultat.
+template <typename K, typename V>
+class QueryExecutor {
+private:
+    ThreadPool& pool;
+    size_t grain;   // Requêtes par tâche
+
+    static void run(const Index<K, V>& index, const Query<K>& query, QueryResult<K, V>& result) {
+        switch (query.type) {
+            case Query<K>::Type::GET: {
+                auto elements = index.getElements(query.lo);
+                result.elements.assign(elements.begin(), elements.end());
+                result.count = static_cast<int>(result.elements.size());
+                break;
+            }
+            case Query<K>::Type::COUNT:
+                result.count = index.countRange(query.lo, query.hi);
+                break;
+            case Query<K>::Type::RANGE: {
+                auto elements = index.getRange(query.lo, query.hi);
+                result.elements.assign(elements.begin(), elements.end());
+                result.count = static_cast<int>(result.elements.size());
+                break;
+            }
+        }
+    }
+
+public:
+    explicit QueryExecutor(ThreadPool& pool = ThreadPool::instance(), size_t grain = 64)
+        : pool(pool), grain(std::max<size_t>(1, grain)) {}
+
+    // Exécute le lot sur view et attend tous les résultats
+    BatchResult<K, V> execute(std::shared_ptr<const Index<K, V>> view, const std::vector<Query<K>>& queries) const {
+        auto start = std::chrono::steady_clock::now();
+        BatchResult<K, V> batch;
+        batch.view = std::move(view);
+        batch.results.resize(queries.size());
+
+        parallelFor(0, queries.size(), grain, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                run(*batch.view, queries[i], batch.results[i]);
+            }
+        }, pool);
+        batch.latencyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return batch;
+    }
+
+    // Exécute le lot sur un instantané de l'index
+    BatchResult<K, V> execute(const Index<K, V>& index, const std::vector<Query<K>>& queries) const {
+        return execute(index.snapshot(), queries);
+    }
+
+    // Analyse une requête "get clé", "count clé [clé_max]" ou "range clé_min clé_max".
+    // Retourne false pour une ligne vide, un commentaire (#) ou une requête invalide.
+    static bool parseQuery(const std::string& line, Query<K>& query) {
+        std::istringstream iss(line);
+        std::string command, lo, hi;
+        if (!(iss >> command) || command[0] == '#' || !(iss >> lo)) {
+            return false;
+        }
+        bool hasHi = static_cast<bool>(iss >> hi);
+
+        if (command == "get" && !hasHi) {
+            query.type = Query<K>::Type::GET;
+        } else if (command == "count") {
+            query.type = Query<K>::Type::COUNT;
+        } else if (command == "range" && hasHi) {
+            query.type = Query<K>::Type::RANGE;
+        } else {
+            return false;
+        }
+
+        try {
+            query.lo = convertFromString<K>(lo);
+            query.hi = hasHi ? convertFromString<K>(hi) : query.lo;
+            return true;
+        }
+        catch (const std::exception&) {
+            return false;
+        }
+    }
+};
+
+#endif // QUERY_EXECUTOR_H
@@ -0,0 +1,264 @@
+#ifndef RCU_INDEX_H
+#define RCU_INDEX_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <iterator>
+#include "Element.h"
+#include "EpochDomain.h"
+
+// Index à lecture sans verrou (read-copy-update).
+// Les lecteurs ne prennent aucun verrou et ne font aucune opération atomique
+// lecture-modification-écriture : ils lisent la version publiée du répertoire, protégés
+// par une section EpochDomain::Guard. Les rédacteurs (sérialisés entre eux) construisent
+// une nouvelle version en recopiant le répertoire et les seuls nœuds modifiés, la publient
+// atomiquement, puis retirent l'ancienne version, libérée par époques.
+// Convient aux charges très majoritairement en lecture ; préférer insertBatch pour écrire
+// beaucoup d'éléments, chaque écriture recopiant le répertoire.
+template <typename K, typename V>
+class RcuIndex {
+private:
+    // Nœud immuable une fois publié : éléments triés par valeur
+    struct RcuNode {
+        K key;
+        std::vector<Element<K, V>> elements;
+    };
+
+    // Version du répertoire : nœuds triés par clé, partagés entre versions successives
+    struct Directory {
+        std::vector<const RcuNode*> nodes;
+        int nbElements = 0;
+    };
+
+    std::atomic<const Directory*> current;
+    std::mutex writerMutex;   // Sérialise les rédacteurs
+
+    static bool valueLess(const Element<K, V>& a, const Element<K, V>& b) {
+        return a.getValue() < b.getValue();
+    }
+
+    static typename std::vector<const RcuNode*>::const_iterator
+    lowerBound(const Directory* directory, const K& key) {
+        return std::lower_bound(directory->nodes.begin(), directory->nodes.end(), key,
+                                [](const RcuNode* node, const K& k) {
+                                    return node->key < k;
+                                });
+    }
+
+    // Nœud de clé key dans une version, ou nullptr
+    static const RcuNode* findNode(const Directory* directory, const K& key) {
+        auto it = lowerBound(directory, key);
+        if (it != directory->nodes.end() && (*it)->key == key) {
+            return *it;
+        }
+        return nullptr;
+    }
+
+    // Publie une nouvelle version et retire l'ancienne ainsi que les nœuds remplacés, avec
+    // leur taille : une copie de grand répertoire déclenche à elle seule la collecte
+    void publish(Directory* next, const std::vector<const RcuNode*>& replaced) {
+        const Directory* previous = current.exchange(next, std::memory_order_acq_rel);
+        EpochDomain& domain = EpochDomain::instance();
+        domain.retire(previous, sizeof(Directory) + previous->nodes.capacity() * sizeof(const RcuNode*));
+        for (const RcuNode* node : replaced) {
+            domain.retire(node, sizeof(RcuNode) + node->elements.capacity() * sizeof(Element<K, V>));
+        }
+    }
+
+    // Remplace (ou retire si replacement est nullptr) le nœud de clé key
+    void replaceNode(const K& key, const RcuNode* replacement) {
+        const Directory* directory = current.load(std::memory_order_relaxed);
+        Directory* next = new Directory(*directory);
+        auto it = next->nodes.begin() + (lowerBound(directory, key) - directory->nodes.begin());
+
+        std::vector<const RcuNode*> replaced;
+        if (it != next->nodes.end() && (*it)->key == key) {
+            next->nbElements -= static_cast<int>((*it)->elements.size());
+            replaced.push_back(*it);
+            if (replacement != nullptr) {
+                *it = replacement;
+            } else {
+                next->nodes.erase(it);
+            }
+        } else if (replacement != nullptr) {
+            next->nodes.insert(it, replacement);
+        }
+        if (replacement != nullptr) {
+            next->nbElements += static_cast<int>(replacement->elements.size());
+        }
+        publish(next, replaced);
+    }
+
+public:
+    // Constructeur
+    RcuIndex() : current(new Directory()) {}
+
+    // Destructeur - aucun lecteur ne doit encore utiliser l'index
+    ~RcuIndex() {
+        const Directory* directory = current.load();
+        for (const RcuNode* node : directory->nodes) {
+            delete node;
+        }
+        delete directory;
+    }
+
+    RcuIndex(const RcuIndex&) = delete;
+    RcuIndex& operator=(const RcuIndex&) = delete;
+
+    // Lecture sans copie : f reçoit les éléments (triés par valeur) de la clé, s'il y en a.
+    // Les références ne restent valides que pendant l'appel de f.
+    template <typename F>
+    bool visitElements(const K& key, F f) const {
+        EpochDomain::Guard guard;
+        const RcuNode* node = findNode(current.load(std::memory_order_acquire), key);
+        if (node == nullptr) {
+            return false;
+        }
+        f(static_cast<const std::vector<Element<K, V>>&>(node->elements));
+        return true;
+    }
+
+    // Retourne une copie des éléments correspondant à une clé
+    std::vector<Element<K, V>> getElements(const K& key) const {
+        std::vector<Element<K, V>> result;
+        visitElements(key, [&result](const std::vector<Element<K, V>>& elements) {
+            result = elements;
+        });
+        return result;
+    }
+
+    bool contains(const K& key) const {
+        EpochDomain::Guard guard;
+        return findNode(current.load(std::memory_order_acquire), key) != nullptr;
+    }
+
+    int getNbElements() const {
+        EpochDomain::Guard guard;
+        return current.load(std::memory_order_acquire)->nbElements;
+    }
+
+    int getNbNodes() const {
+        EpochDomain::Guard guard;
+        return static_cast<int>(current.load(std::memory_order_acquire)->nodes.size());
+    }
+
+    // Ajoute un élément : seul son nœud est recopié
+    void addElement(const K& key, const V& value) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        const RcuNode* node = findNode(current.load(std::memory_order_relaxed), key);
+
+        RcuNode* updated = node != nullptr ? new RcuNode(*node) : new RcuNode{key, {}};
+        Element<K, V> element(key, value);
+        updated->elements.insert(std::upper_bound(updated->elements.begin(), updated->elements.end(),
+                                                  element, valueLess),
+                                 element);
+        replaceNode(key, updated);
+    }
+
+    // Supprime un élément égal à element ; le nœud est retiré s'il devient vide
+    bool deleteElement(const Element<K, V>& element) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        const RcuNode* node = findNode(current.load(std::memory_order_relaxed), element.getKey());
+        if (node == nullptr) {
+            return false;
+        }
+
+        auto range = std::equal_range(node->elements.begin(), node->elements.end(), element, valueLess);
+        auto found = std::find(range.first, range.second, element);
+        if (found == range.second) {
+            return false;
+        }
+
+        RcuNode* updated = nullptr;
+        if (node->elements.size() > 1) {
+            updated = new RcuNode{node->key, {}};
+            updated->elements.reserve(node->elements.size() - 1);
+            updated->elements.insert(updated->elements.end(), node->elements.begin(), found);
+            updated->elements.insert(updated->elements.end(), found + 1, node->elements.end());
+        }
+        replaceNode(element.getKey(), updated);
+        return true;
+    }
+
+    bool deleteNode(const K& key) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        if (findNode(current.load(std::memory_order_relaxed), key) == nullptr) {
+            return false;
+        }
+        replaceNode(key, nullptr);
+        return true;
+    }
+
+    // Insertion groupée : une seule nouvelle version pour tout le lot
+    template <typename Range>
+    void insertBatch(const Range& pairs) {
+        std::vector<Element<K, V>> batch;
+        for (const auto& pair : pairs) {
+            batch.emplace_back(pair.first, pair.second);
+        }
+        if (batch.empty()) {
+            return;
+        }
+        std::stable_sort(batch.begin(), batch.end());
+
+        std::lock_guard<std::mutex> lock(writerMutex);
+        const Directory* directory = current.load(std::memory_order_relaxed);
+        Directory* next = new Directory();
+        next->nodes.reserve(directory->nodes.size() + batch.size());
+        next->nbElements = directory->nbElements + static_cast<int>(batch.size());
+
+        std::vector<const RcuNode*> replaced;
+        auto nodeIt = directory->nodes.begin();
+        auto first = batch.begin();
+        while (first != batch.end()) {
+            const K& key = first->getKey();
+            auto last = std::find_if(first, batch.end(),
+                                     [&key](const Element<K, V>& e) {
+                                         return e.getKey() != key;
+                                     });
+
+            while (nodeIt != directory->nodes.end() && (*nodeIt)->key < key) {
+                next->nodes.push_back(*nodeIt++);
+            }
+
+            RcuNode* updated = new RcuNode{key, {}};
+            if (nodeIt != directory->nodes.end() && (*nodeIt)->key == key) {
+                const RcuNode* old = *nodeIt++;
+                updated->elements.reserve(old->elements.size() + (last - first));
+                std::merge(old->elements.begin(), old->elements.end(), first, last,
+                           std::back_inserter(updated->elements), valueLess);
+                replaced.push_back(old);
+            } else {
+                updated->elements.assign(first, last);
+            }
+            next->nodes.push_back(updated);
+            first = last;
+        }
+        next->nodes.insert(next->nodes.end(), nodeIt, directory->nodes.end());
+
+        publish(next, replaced);
+    }
+
+    // Affichage d'une version cohérente de l'index
+    friend std::ostream& operator<<(std::ostream& os, const RcuIndex<K, V>& index) {
+        EpochDomain::Guard guard;
+        const Directory* directory = index.current.load(std::memory_order_acquire);
+        os << "Index{" << std::endl;
+        for (const RcuNode* node : directory->nodes) {
+            os << "  Node[key=" << node->key << ", elements=" << node->elements.size() << "]{";
+            for (size_t i = 0; i < node->elements.size(); ++i) {
+                if (i > 0) os << ", ";
+                os << node->elements[i];
+            }
+            os << "}" << std::endl;
+        }
+        os << "}";
+        return os;
+    }
+};
+
+#endif // RCU_INDEX_H
@@ -0,0 +1,127 @@
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "Element.h"
+#include "BufferedWriter.h"
+#include "ThreadPool.h"
+
+// Présentation d'un élément par ResultWriter
+enum class ResultFormat {
+    TEXT,   // Element[key=..., value=...], comme operator<<
+    TSV     // clé<TAB>valeur
+};
+
+// Ajoute la ligne d'un élément à text
+template <typename K, typename V>
+void formatElement(const Element<K, V>& element, ResultFormat format, std::string& text) {
+    if (format == ResultFormat::TSV) {
+        appendText(text, element.getKey());
+        text += '\t';
+        appendText(text, element.getValue());
+    } else {
+        text += "Element[key=";
+        appendText(text, element.getKey());
+        text += ", value=";
+        appendText(text, element.getValue());
+        text += ']';
+    }
+    text += '\n';
+}
+
+// Écrit des éléments en flux, un par ligne, à travers un BufferedWriter (aucun vidage par
+// ligne). Seule la page [offset, offset + limit) des éléments reçus est écrite : write()
+// retourne false une fois la page pleine, pour que l'appelant arrête son parcours.
+template <typename K, typename V>
+class ResultWriter {
+public:
+    static constexpr size_t NoLimit = static_cast<size_t>(-1);
+
+    explicit ResultWriter(BufferedWriter& out, ResultFormat format = ResultFormat::TEXT,
+                          size_t offset = 0, size_t limit = NoLimit)
+        : out(out), format(format), offset(offset), limit(limit) {}
+
+    // Écrit element s'il tombe dans la page ; false si la page est pleine
+    bool write(const Element<K, V>& element) {
+        if (isFull()) {
+            return false;
+        }
+        if (skipped < offset) {
+            ++skipped;
+            return true;
+        }
+        line.clear();
+        formatElement(element, format, line);
+        out.write(line);
+        ++written;
+        return !isFull();
+    }
+
+    // Écrit une suite de pointeurs d'éléments ; false si la page est pleine
+    template <typename It>
+    bool write(It first, It last) {
+        for (; first != last; ++first) {
+            if (!write(**first)) {
+                return false;
+            }
+        }
+        return !isFull();
+    }
+
+    // Comme write(first, last), pour les longues suites : les lignes sont formatées en
+    // parallèle par tranches de grain éléments, puis écrites dans l'ordre
+    bool writeParallel(const std::vector<Element<K, V>*>& elements, ThreadPool& pool = ThreadPool::instance(),
+                       size_t grain = 1 << 14) {
+        size_t begin = std::min(elements.size(), offset - skipped);
+        skipped += begin;
+        size_t end = begin + std::min(elements.size() - begin, limit - written);
+        grain = std::max<size_t>(1, grain);
+
+        // Fenêtres de quelques tranches par thread : la mémoire formatée reste bornée
+        const size_t window = grain * pool.size() * 4;
+        std::vector<std::string> chunks;
+        for (size_t lo = begin; lo < end; lo += window) {
+            size_t hi = std::min(end, lo + window);
+            chunks.assign((hi - lo + grain - 1) / grain, std::string());
+            parallelFor(0, chunks.size(), 1, [&](size_t first, size_t last) {
+                for (size_t chunk = first; chunk < last; ++chunk) {
+                    size_t from = lo + chunk * grain;
+                    size_t to = std::min(hi, from + grain);
+                    for (size_t i = from; i < to; ++i) {
+                        formatElement(*elements[i], format, chunks[chunk]);
+                    }
+                }
+            }, pool);
+            for (const auto& chunk : chunks) {
+                out.write(chunk);
+            }
+        }
+        written += end - begin;
+        return !isFull();
+    }
+
+    bool isFull() const {
+        return written >= limit;
+    }
+
+    size_t getWritten() const {
+        return written;
+    }
+
+    size_t getSkipped() const {
+        return skipped;
+    }
+
+private:
+    BufferedWriter& out;
+    ResultFormat format;
+    size_t offset;
+    size_t limit;
+    size_t skipped = 0;    // Éléments reçus avant la page
+    size_t written = 0;    // Éléments écrits
+    std::string line;
+};
+
+#endif // RESULT_WRITER_H
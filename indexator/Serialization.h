@@ -0,0 +1,111 @@
+#ifndef SERIALIZATION_H
+#define SERIALIZATION_H
+
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+// Lecture et écriture binaires des types de clés et de valeurs des index.
+// Les types simples (char, int...) sont écrits tels quels, dans l'ordre d'octets de la
+// machine ; les chaînes sont préfixées par leur longueur sur 64 bits.
+
+template <typename T>
+void writeBinary(std::ostream& os, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Type non sérialisable");
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+inline void writeBinary(std::ostream& os, const std::string& value) {
+    uint64_t size = value.size();
+    writeBinary(os, size);
+    os.write(value.data(), static_cast<std::streamsize>(size));
+}
+
+// Retourne false si le flux est épuisé ou en erreur
+template <typename T>
+bool readBinary(std::istream& is, T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Type non sérialisable");
+    is.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(is);
+}
+
+// Octets restant à lire dans le flux (maximum s'il ne permet pas de se positionner)
+inline uint64_t remainingBytes(std::istream& is) {
+    std::streampos current = is.tellg();
+    if (current == std::streampos(-1)) {
+        return UINT64_MAX;
+    }
+    is.seekg(0, std::ios::end);
+    std::streampos end = is.tellg();
+    is.seekg(current);
+    return end == std::streampos(-1) || end < current ? UINT64_MAX : static_cast<uint64_t>(end - current);
+}
+
+// Taille minimale d'une valeur sérialisée, pour vérifier un nombre lu avant d'allouer
+template <typename T>
+struct MinBinarySize { static constexpr uint64_t value = sizeof(T); };
+template <>
+struct MinBinarySize<std::string> { static constexpr uint64_t value = sizeof(uint64_t); };
+
+inline bool readBinary(std::istream& is, std::string& value) {
+    uint64_t size;
+    if (!readBinary(is, size)) {
+        return false;
+    }
+    // Longueur invraisemblable (fichier tronqué ou étranger) : refusée avant d'allouer.
+    // Les chaînes courtes sont lues sans vérification, le flux échoue de lui-même.
+    if (size > (1 << 16) && size > remainingBytes(is)) {
+        is.setstate(std::ios::failbit);
+        return false;
+    }
+    value.resize(size);
+    is.read(&value[0], static_cast<std::streamsize>(size));
+    return static_cast<bool>(is);
+}
+
+// Identifiant de type écrit dans les en-têtes, pour refuser un fichier d'un autre type d'index
+template <typename T> struct BinaryTag;
+template <> struct BinaryTag<char> { static constexpr uint8_t value = 1; };
+template <> struct BinaryTag<int> { static constexpr uint8_t value = 2; };
+template <> struct BinaryTag<std::string> { static constexpr uint8_t value = 3; };
+
+// Instantanés binaires d'index (voir Index::saveSnapshot) : signature, version du format,
+// types de clé et de valeur, nombre de nœuds, puis pour chaque nœud sa clé, son nombre
+// d'éléments et leurs valeurs triées.
+constexpr char SnapshotMagic[4] = {'I', 'D', 'X', 'S'};
+constexpr uint32_t SnapshotVersion = 1;
+
+template <typename K, typename V>
+void writeSnapshotHeader(std::ostream& os, uint64_t nbNodes) {
+    os.write(SnapshotMagic, sizeof(SnapshotMagic));
+    writeBinary(os, SnapshotVersion);
+    writeBinary(os, BinaryTag<K>::value);
+    writeBinary(os, BinaryTag<V>::value);
+    writeBinary(os, nbNodes);
+}
+
+// Lit et vérifie l'en-tête d'un instantané d'index K/V ; false si la signature, la version
+// du format ou les types ne correspondent pas
+template <typename K, typename V>
+bool readSnapshotHeader(std::istream& is, uint64_t& nbNodes) {
+    char magic[sizeof(SnapshotMagic)];
+    uint32_t formatVersion;
+    uint8_t keyTag, valueTag;
+    is.read(magic, sizeof(magic));
+    return is && std::equal(magic, magic + sizeof(magic), SnapshotMagic)
+           && readBinary(is, formatVersion) && formatVersion == SnapshotVersion
+           && readBinary(is, keyTag) && keyTag == BinaryTag<K>::value
+           && readBinary(is, valueTag) && valueTag == BinaryTag<V>::value
+           && readBinary(is, nbNodes);
+}
+
+// Vrai si nbNodes nœuds de type K peuvent tenir dans la suite du flux : chacun occupe au
+// moins sa clé et son nombre d'éléments
+template <typename K>
+bool snapshotNodesFit(std::istream& is, uint64_t nbNodes) {
+    return nbNodes <= remainingBytes(is) / (MinBinarySize<K>::value + sizeof(uint64_t));
+}
+
+#endif // SERIALIZATION_H
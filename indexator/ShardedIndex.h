@@ -0,0 +1,267 @@
+#ifndef SHARDED_INDEX_H
+#define SHARDED_INDEX_H
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include "Element.h"
+#include "Node.h"
+#include "Index.h"
+#include "ThreadPool.h"
+
+// Index réparti en plusieurs Index indépendants (shards) selon le hachage de la clé.
+// Chaque shard a son propre verrou lecteurs/rédacteur : des threads qui écrivent des clés
+// de shards différents ne se gênent pas. Une clé n'appartient qu'à un seul shard ; les
+// parcours ordonnés (affichage, intervalles) fusionnent les shards à la volée.
+// Les lectures retournent des copies des éléments.
+template <typename K, typename V>
+class ShardedIndex {
+private:
+    struct Shard {
+        Index<K, V> index;
+        mutable std::shared_mutex mutex;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    size_t shardOf(const K& key) const {
+        return std::hash<K>{}(key) % shards.size();
+    }
+
+    // Verrouille tous les shards en lecture (toujours dans le même ordre)
+    std::vector<std::shared_lock<std::shared_mutex>> lockAllShared() const {
+        std::vector<std::shared_lock<std::shared_mutex>> locks;
+        locks.reserve(shards.size());
+        for (const auto& shard : shards) {
+            locks.emplace_back(shard->mutex);
+        }
+        return locks;
+    }
+
+    // Fusion ordonnée des nœuds de tous les shards (shards verrouillés par l'appelant).
+    // f(const Node<K, V>&) est appelé pour chaque nœud dans l'ordre des clés.
+    template <typename F>
+    void mergeNodes(F f, const K* lo = nullptr, const K* hi = nullptr) const {
+        std::vector<std::vector<const Node<K, V>*>> runs(shards.size());
+        for (size_t i = 0; i < shards.size(); ++i) {
+            shards[i]->index.forEachNode([&](const Node<K, V>& node) {
+                if ((lo == nullptr || !(node.getKey() < *lo)) && (hi == nullptr || !(*hi < node.getKey()))) {
+                    runs[i].push_back(&node);
+                }
+            });
+        }
+
+        // Fusion k voies : tas des têtes de chaque shard
+        using Head = std::pair<size_t, size_t>;  // (shard, position)
+        auto greater = [&runs](const Head& a, const Head& b) {
+            return runs[b.first][b.second]->getKey() < runs[a.first][a.second]->getKey();
+        };
+        std::vector<Head> heap;
+        for (size_t i = 0; i < runs.size(); ++i) {
+            if (!runs[i].empty()) {
+                heap.emplace_back(i, 0);
+            }
+        }
+        std::make_heap(heap.begin(), heap.end(), greater);
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), greater);
+            Head& head = heap.back();
+            f(*runs[head.first][head.second]);
+            if (++head.second < runs[head.first].size()) {
+                std::push_heap(heap.begin(), heap.end(), greater);
+            } else {
+                heap.pop_back();
+            }
+        }
+    }
+
+    // Insère les paires réparties par shard, une tâche par shard, sans verrou global
+    void insertPartitioned(std::vector<std::vector<std::pair<K, V>>>& perShard) {
+        TaskGroup group;
+        for (size_t i = 0; i < shards.size(); ++i) {
+            if (perShard[i].empty()) {
+                continue;
+            }
+            group.run([this, i, &perShard]() {
+                std::unique_lock<std::shared_mutex> lock(shards[i]->mutex);
+                shards[i]->index.insertBatch(perShard[i]);
+            });
+        }
+        group.wait();
+    }
+
+public:
+    // Constructeur : nbShards index indépendants (par défaut, un par cœur)
+    explicit ShardedIndex(size_t nbShards = std::max(1u, std::thread::hardware_concurrency())) {
+        for (size_t i = 0; i < std::max<size_t>(1, nbShards); ++i) {
+            shards.push_back(std::make_unique<Shard>());
+        }
+    }
+
+    ShardedIndex(const ShardedIndex&) = delete;
+    ShardedIndex& operator=(const ShardedIndex&) = delete;
+
+    size_t getNbShards() const { return shards.size(); }
+
+    // Retourne le nombre total d'éléments (compteurs atomiques des shards, sans verrou)
+    int getNbElements() const {
+        int count = 0;
+        for (const auto& shard : shards) {
+            count += shard->index.getNbElements();
+        }
+        return count;
+    }
+
+    int getNbNodes() const {
+        int count = 0;
+        for (const auto& shard : shards) {
+            std::shared_lock<std::shared_mutex> lock(shard->mutex);
+            count += shard->index.getNbNodes();
+        }
+        return count;
+    }
+
+    // Retourne une copie des éléments correspondant à une clé
+    std::vector<Element<K, V>> getElements(const K& key) const {
+        std::vector<Element<K, V>> result;
+        const Shard& shard = *shards[shardOf(key)];
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (const auto* element : shard.index.getElements(key)) {
+            result.push_back(*element);
+        }
+        return result;
+    }
+
+    // Retourne une copie des éléments de clé dans [lo, hi], par clé puis valeur
+    std::vector<Element<K, V>> getRange(const K& lo, const K& hi) const {
+        std::vector<Element<K, V>> result;
+        auto locks = lockAllShared();
+        mergeNodes([&result](const Node<K, V>& node) {
+            for (const auto* element : node.getAllElements()) {
+                result.push_back(*element);
+            }
+        }, &lo, &hi);
+        return result;
+    }
+
+    // Ajoute un élément (l'index en prend possession)
+    void addElement(Element<K, V>* element) {
+        Shard& shard = *shards[shardOf(element->getKey())];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.index.addElement(element);
+    }
+
+    void addElement(const K& key, const V& value) {
+        addElement(new Element<K, V>(key, value));
+    }
+
+    // Supprime un élément égal à element
+    bool deleteElement(const Element<K, V>& element) {
+        Element<K, V> target(element);
+        Shard& shard = *shards[shardOf(target.getKey())];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.index.deleteElement(&target);
+    }
+
+    bool deleteNode(const K& key) {
+        Shard& shard = *shards[shardOf(key)];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.index.deleteNode(key);
+    }
+
+    // Insertion groupée : les paires sont réparties par shard puis insérées en parallèle
+    template <typename Range>
+    void insertBatch(const Range& pairs) {
+        std::vector<std::vector<std::pair<K, V>>> perShard(shards.size());
+        for (const auto& pair : pairs) {
+            perShard[shardOf(pair.first)].emplace_back(pair.first, pair.second);
+        }
+        insertPartitioned(perShard);
+    }
+
+    // Taille des blocs de texte lus par loadFromFile
+    static constexpr size_t BlockBytes = size_t(4) << 20;
+
+    // Charge un fichier : il est lu par blocs d'environ BlockBytes octets, dont l'analyse
+    // est répartie en tâches, chacune remplissant ses propres paquets par shard ; seul le
+    // bloc courant est gardé sous forme de texte. Chaque shard est ensuite construit en
+    // parallèle dans un index neuf, échangé sous le verrou de ce seul shard. Les tâches
+    // s'exécutent sur la réserve de threads partagée.
+    bool loadFromFile(const std::string& filename, size_t threads = std::max(1u, std::thread::hardware_concurrency())) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Erreur: Impossible d'ouvrir le fichier " << filename << std::endl;
+            return false;
+        }
+
+        // buckets[t][s] reçoit les paires de la tâche t pour le shard s
+        threads = std::max<size_t>(1, threads);
+        std::vector<std::vector<std::vector<std::pair<K, V>>>> buckets(
+            threads, std::vector<std::vector<std::pair<K, V>>>(shards.size()));
+        std::vector<std::string> lines;
+        std::string line;
+        bool more = true;
+        while (more) {
+            lines.clear();
+            size_t bytes = 0;
+            while (bytes < BlockBytes && (more = static_cast<bool>(std::getline(file, line)))) {
+                bytes += line.size() + 1;
+                lines.push_back(std::move(line));
+            }
+
+            // Analyse parallèle du bloc, découpé en une tranche par tâche
+            size_t chunk = (lines.size() + threads - 1) / threads;
+            parallelFor(0, threads, 1, [&](size_t first, size_t last) {
+                K key;
+                V value;
+                for (size_t t = first; t < last; ++t) {
+                    size_t end = std::min(lines.size(), (t + 1) * chunk);
+                    for (size_t i = t * chunk; i < end; ++i) {
+                        if (Index<K, V>::parseLine(lines[i], key, value)) {
+                            buckets[t][shardOf(key)].emplace_back(key, value);
+                        }
+                    }
+                }
+            });
+        }
+        file.close();
+        std::vector<std::string>().swap(lines);
+
+        parallelFor(0, shards.size(), 1, [&](size_t first, size_t last) {
+            for (size_t s = first; s < last; ++s) {
+                std::vector<std::pair<K, V>> pairs;
+                for (size_t t = 0; t < threads; ++t) {
+                    pairs.insert(pairs.end(), std::make_move_iterator(buckets[t][s].begin()),
+                                 std::make_move_iterator(buckets[t][s].end()));
+                    std::vector<std::pair<K, V>>().swap(buckets[t][s]);
+                }
+                Index<K, V> loaded;
+                loaded.insertBatch(pairs);
+                std::unique_lock<std::shared_mutex> lock(shards[s]->mutex);
+                shards[s]->index.swap(loaded);
+            }
+        });
+        return true;
+    }
+
+    // Affichage ordonné : les shards sont fusionnés par clé
+    friend std::ostream& operator<<(std::ostream& os, const ShardedIndex<K, V>& sharded) {
+        auto locks = sharded.lockAllShared();
+        os << "Index{" << std::endl;
+        sharded.mergeNodes([&os](const Node<K, V>& node) {
+            os << "  " << node << std::endl;
+        });
+        os << "}";
+        return os;
+    }
+};
+
+#endif // SHARDED_INDEX_H
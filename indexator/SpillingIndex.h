@@ -0,0 +1,520 @@
+#ifndef SPILLING_INDEX_H
+#define SPILLING_INDEX_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <list>
+#include <memory>
+#include <algorithm>
+#include <utility>
+#include <cstdio>
+#include <cstdint>
+#include <filesystem>
+#include "Element.h"
+#include "Node.h"
+#include "Index.h"
+#include "Serialization.h"
+
+// Compteurs d'un index à mémoire bornée (voir SpillingIndex::getSpillStats)
+struct SpillStats {
+    uint64_t hits = 0;            // Accès à un nœud résident
+    uint64_t misses = 0;          // Nœuds relus depuis le fichier d'échange
+    uint64_t evictions = 0;       // Nœuds évincés de la mémoire
+    uint64_t spillWrites = 0;     // Nœuds écrits dans le fichier d'échange
+    uint64_t compactions = 0;     // Réécritures du fichier d'échange
+    size_t residentNodes = 0;
+    size_t spilledNodes = 0;
+    size_t residentBytes = 0;     // Estimation mémoire des nœuds résidents
+    size_t memoryBudget = 0;
+    uint64_t spillFileBytes = 0;
+    uint64_t garbageBytes = 0;    // Part du fichier d'échange qui n'est plus référencée
+
+    double hitRate() const {
+        return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / (hits + misses);
+    }
+};
+
+// Index dont les nœuds résidents tiennent dans un budget mémoire fixe. Le répertoire des
+// clés reste en mémoire (une clé absente se vérifie sans lecture disque), mais les éléments
+// des nœuds les moins récemment utilisés (LRU) sont évincés vers un fichier d'échange et
+// relus à la demande par getElements. Un nœud relu et non modifié depuis garde sa copie
+// sur disque : sa prochaine éviction ne réécrit rien. Le fichier d'échange est réécrit
+// quand la place perdue dépasse la moitié de sa taille.
+// Le budget couvre les nœuds et leurs éléments, pas le répertoire. Un nœud seul plus gros
+// que le budget reste résident tant qu'il est le plus récent. Les lectures retournent des
+// copies des éléments. Pas de synchronisation : un seul thread à la fois.
+template <typename K, typename V>
+class SpillingIndex {
+private:
+    struct Slot;
+    using Directory = std::map<K, Slot>;
+
+    struct Slot {
+        std::unique_ptr<Node<K, V>> node;   // Nœud résident, ou nul s'il est évincé
+        int nbElements = 0;
+        size_t elementBytes = 0;            // Estimation mémoire des éléments (nœud résident)
+        size_t bytes = 0;                   // Part de residentBytes comptée pour ce nœud
+        typename std::list<typename Directory::iterator>::iterator lruPosition;
+        bool onDisk = false;                // Copie à jour dans le fichier d'échange
+        uint64_t offset = 0;                // Position et taille de cette copie
+        uint64_t length = 0;
+    };
+
+    static constexpr uint64_t MinCompaction = 1 << 20;   // Place perdue tolérée sans réécriture
+
+    Directory directory;
+    std::list<typename Directory::iterator> lru;   // Nœuds résidents, du plus récent au plus ancien
+    int nbElements = 0;
+    size_t memoryBudget;
+    size_t residentBytes = 0;
+
+    std::string spillPath;
+    std::fstream spill;
+    uint64_t spillFileBytes = 0;
+    uint64_t garbageBytes = 0;
+    bool spillFailed = false;   // Écriture impossible : plus d'éviction
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t spillWrites = 0;
+    uint64_t compactions = 0;
+
+    static size_t elementBytesOf(const K& key, const V& value) {
+        return sizeof(Element<K, V>) + heapBytes(key) + heapBytes(value);
+    }
+
+    // Met à jour la part du nœud dans residentBytes après une modification
+    void account(Slot& slot) {
+        residentBytes -= slot.bytes;
+        slot.bytes = slot.node->estimateNodeBytes() + slot.elementBytes;
+        residentBytes += slot.bytes;
+    }
+
+    // La copie sur disque du nœud n'est plus à jour
+    void discardSpilled(Slot& slot) {
+        if (slot.onDisk) {
+            garbageBytes += slot.length;
+            slot.onDisk = false;
+        }
+    }
+
+    // Rend le nœud résident (en le relisant s'il est évincé) et le marque le plus récent
+    Node<K, V>* residentNode(typename Directory::iterator it) {
+        Slot& slot = it->second;
+        if (slot.node) {
+            ++hits;
+            lru.splice(lru.begin(), lru, slot.lruPosition);
+            return slot.node.get();
+        }
+
+        slot.node.reset(new Node<K, V>(it->first));
+        slot.elementBytes = 0;
+        if (slot.nbElements > 0) {   // Sinon : clé tout juste créée
+            ++misses;
+            std::vector<Element<K, V>*> elements;
+            elements.reserve(slot.nbElements);
+            spill.clear();
+            spill.seekg(static_cast<std::streamoff>(slot.offset));
+            V value;
+            for (int i = 0; i < slot.nbElements && readBinary(spill, value); ++i) {
+                elements.push_back(new Element<K, V>(it->first, value));
+                slot.elementBytes += elementBytesOf(it->first, value);
+            }
+            // Lecture incomplète : les compteurs suivent les éléments effectivement relus et
+            // la copie sur disque, inutilisable, sera réécrite à la prochaine éviction
+            int lost = slot.nbElements - static_cast<int>(elements.size());
+            if (lost > 0) {
+                std::cerr << "Erreur: Nœud illisible dans le fichier d'échange " << spillPath << ", "
+                          << lost << " élément(s) perdu(s)" << std::endl;
+                slot.nbElements -= lost;
+                nbElements -= lost;
+                discardSpilled(slot);
+            }
+            // Valeurs écrites dans l'ordre du nœud : fusion sans tri
+            slot.node->mergeElements(elements.begin(), elements.end());
+        }
+        lru.push_front(it);
+        slot.lruPosition = lru.begin();
+        account(slot);
+        return slot.node.get();
+    }
+
+    // Écrit les éléments du nœud en fin de fichier d'échange
+    bool writeSpilled(Slot& slot) {
+        spill.clear();
+        spill.seekp(static_cast<std::streamoff>(spillFileBytes));
+        for (const auto* element : slot.node->getAllElements()) {
+            writeBinary(spill, element->getValue());
+        }
+        uint64_t end = static_cast<uint64_t>(spill.tellp());
+        if (!spill) {
+            std::cerr << "Erreur: Écriture impossible dans le fichier d'échange " << spillPath
+                      << ", éviction désactivée" << std::endl;
+            spillFailed = true;
+            return false;
+        }
+        slot.offset = spillFileBytes;
+        slot.length = end - spillFileBytes;
+        slot.onDisk = true;
+        spillFileBytes = end;
+        ++spillWrites;
+        return true;
+    }
+
+    // Évince les nœuds les moins récents jusqu'à revenir dans le budget
+    void enforceBudget() {
+        while (residentBytes > memoryBudget && lru.size() > 1 && !spillFailed) {
+            auto it = lru.back();
+            Slot& slot = it->second;
+            if (!slot.onDisk && !writeSpilled(slot)) {
+                return;
+            }
+            residentBytes -= slot.bytes;
+            slot.bytes = 0;
+            slot.elementBytes = 0;
+            slot.node.reset();
+            lru.pop_back();
+            ++evictions;
+        }
+        if (garbageBytes > MinCompaction && garbageBytes * 2 > spillFileBytes) {
+            compactSpillFile();
+        }
+    }
+
+    // Réécrit le fichier d'échange avec les seules copies encore référencées, dans leur
+    // ordre sur disque
+    void compactSpillFile() {
+        std::vector<Slot*> kept;
+        for (auto& entry : directory) {
+            if (entry.second.onDisk) {
+                kept.push_back(&entry.second);
+            }
+        }
+        std::sort(kept.begin(), kept.end(), [](const Slot* a, const Slot* b) {
+            return a->offset < b->offset;
+        });
+
+        const std::string compacted = spillPath + ".compact";
+        std::ofstream out(compacted, std::ios::binary | std::ios::trunc);
+        std::vector<char> buffer;
+        uint64_t position = 0;
+        std::vector<uint64_t> offsets;
+        offsets.reserve(kept.size());
+        spill.clear();
+        for (Slot* slot : kept) {
+            buffer.resize(static_cast<size_t>(slot->length));
+            spill.seekg(static_cast<std::streamoff>(slot->offset));
+            spill.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            offsets.push_back(position);
+            position += slot->length;
+        }
+        out.close();
+        if (!spill || !out) {
+            std::cerr << "Erreur: Réécriture impossible du fichier d'échange " << spillPath << std::endl;
+            std::remove(compacted.c_str());
+            spill.clear();
+            return;
+        }
+
+        // Renommé avant de fermer l'ancien fichier : en cas d'échec, il reste utilisable
+        if (std::rename(compacted.c_str(), spillPath.c_str()) != 0) {
+            std::cerr << "Erreur: Impossible de remplacer le fichier d'échange " << spillPath << std::endl;
+            std::remove(compacted.c_str());
+            return;
+        }
+        spill.close();
+        spill.clear();
+        spill.open(spillPath, std::ios::in | std::ios::out | std::ios::binary);
+        if (!spill.is_open()) {
+            std::cerr << "Erreur: Impossible de rouvrir le fichier d'échange " << spillPath
+                      << ", éviction désactivée" << std::endl;
+            spillFailed = true;
+        }
+        for (size_t i = 0; i < kept.size(); ++i) {
+            kept[i]->offset = offsets[i];
+        }
+        spillFileBytes = position;
+        garbageBytes = 0;
+        ++compactions;
+    }
+
+    // Ajoute à la clé de it des éléments triés par valeur (l'index en prend possession)
+    void appendElements(typename Directory::iterator it, std::vector<Element<K, V>*>& elements) {
+        Slot& slot = it->second;
+        Node<K, V>* node = residentNode(it);
+        for (const auto* element : elements) {
+            slot.elementBytes += elementBytesOf(element->getKey(), element->getValue());
+        }
+        node->mergeElements(elements.begin(), elements.end());
+        slot.nbElements += static_cast<int>(elements.size());
+        nbElements += static_cast<int>(elements.size());
+        discardSpilled(slot);
+        account(slot);
+    }
+
+    // Retire la clé de it du répertoire (nœud résident ou évincé)
+    void eraseSlot(typename Directory::iterator it) {
+        Slot& slot = it->second;
+        if (slot.node) {
+            residentBytes -= slot.bytes;
+            lru.erase(slot.lruPosition);
+        }
+        discardSpilled(slot);
+        nbElements -= slot.nbElements;
+        directory.erase(it);
+    }
+
+    void openSpillFile() {
+        spill.close();
+        spill.clear();
+        spill.open(spillPath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+        spillFailed = !spill.is_open();
+        if (spillFailed) {
+            std::cerr << "Erreur: Impossible de créer le fichier d'échange " << spillPath << std::endl;
+        }
+        spillFileBytes = 0;
+        garbageBytes = 0;
+    }
+
+public:
+    // memoryBudget : octets alloués aux nœuds résidents. spillFile : fichier d'échange,
+    // créé (ou vidé) ici et supprimé avec l'index ; par défaut dans le répertoire temporaire.
+    explicit SpillingIndex(size_t memoryBudget, const std::string& spillFile = "")
+        : memoryBudget(memoryBudget), spillPath(spillFile) {
+        if (spillPath.empty()) {
+            spillPath = (std::filesystem::temp_directory_path()
+                         / ("indexator-spill-" + std::to_string(reinterpret_cast<uintptr_t>(this)) + ".tmp")).string();
+        }
+        openSpillFile();
+    }
+
+    ~SpillingIndex() {
+        spill.close();
+        std::remove(spillPath.c_str());
+    }
+
+    SpillingIndex(const SpillingIndex&) = delete;
+    SpillingIndex& operator=(const SpillingIndex&) = delete;
+
+    int getNbElements() const {
+        return nbElements;
+    }
+
+    int getNbNodes() const {
+        return static_cast<int>(directory.size());
+    }
+
+    // Indique si la clé est présente (répertoire seul, sans lecture disque)
+    bool contains(const K& key) const {
+        return directory.find(key) != directory.end();
+    }
+
+    // Retourne une copie des éléments de key, relus depuis le fichier d'échange si le
+    // nœud a été évincé
+    std::vector<Element<K, V>> getElements(const K& key) {
+        std::vector<Element<K, V>> result;
+        auto it = directory.find(key);
+        if (it == directory.end()) {
+            return result;
+        }
+        Node<K, V>* node = residentNode(it);
+        if (it->second.nbElements == 0) {   // Tous ses éléments perdus à la relecture
+            eraseSlot(it);
+            return result;
+        }
+        for (const auto* element : node->getAllElements()) {
+            result.push_back(*element);
+        }
+        enforceBudget();
+        return result;
+    }
+
+    void addElement(const K& key, const V& value) {
+        std::vector<Element<K, V>*> elements{new Element<K, V>(key, value)};
+        appendElements(directory.try_emplace(key).first, elements);
+        enforceBudget();
+    }
+
+    // Supprime un élément égal à element ; le nœud est supprimé s'il devient vide
+    bool deleteElement(const Element<K, V>& element) {
+        auto it = directory.find(element.getKey());
+        if (it == directory.end()) {
+            return false;
+        }
+        Element<K, V> target(element);
+        Slot& slot = it->second;
+        Node<K, V>* node = residentNode(it);
+        if (slot.nbElements == 0) {   // Tous ses éléments perdus à la relecture
+            eraseSlot(it);
+            return false;
+        }
+        if (!node->deleteElement(&target)) {
+            enforceBudget();
+            return false;
+        }
+        slot.elementBytes -= elementBytesOf(target.getKey(), target.getValue());
+        --slot.nbElements;
+        --nbElements;
+        if (slot.nbElements == 0) {
+            eraseSlot(it);
+        } else {
+            discardSpilled(slot);
+            account(slot);
+        }
+        enforceBudget();
+        return true;
+    }
+
+    bool deleteNode(const K& key) {
+        auto it = directory.find(key);
+        if (it == directory.end()) {
+            return false;
+        }
+        eraseSlot(it);
+        enforceBudget();
+        return true;
+    }
+
+    // Insertion groupée : le lot est trié puis chaque clé reçoit sa part en une fois (un
+    // nœud évincé n'est relu qu'une fois par lot)
+    template <typename Range>
+    void insertBatch(const Range& pairs) {
+        std::vector<std::pair<K, V>> sorted(std::begin(pairs), std::end(pairs));
+        std::sort(sorted.begin(), sorted.end());
+        std::vector<Element<K, V>*> elements;
+        for (size_t i = 0; i < sorted.size();) {
+            const K& key = sorted[i].first;
+            elements.clear();
+            for (; i < sorted.size() && sorted[i].first == key; ++i) {
+                elements.push_back(new Element<K, V>(key, sorted[i].second));
+            }
+            appendElements(directory.try_emplace(key).first, elements);
+            enforceBudget();
+        }
+    }
+
+    // Remplace le contenu de l'index par celui du fichier, lu par lots bornés par le budget :
+    // le fichier peut dépasser la mémoire. Un fichier trié par clé se charge sans relecture.
+    bool loadFromFile(const std::string& filename) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Erreur: Impossible d'ouvrir le fichier " << filename << std::endl;
+            return false;
+        }
+
+        directory.clear();
+        lru.clear();
+        nbElements = 0;
+        residentBytes = 0;
+        openSpillFile();
+
+        const size_t batchBytes = std::max<size_t>(memoryBudget / 4, 1 << 16);
+        std::vector<std::pair<K, V>> batch;
+        size_t bytes = 0;
+        std::string line;
+        K key;
+        V value;
+        while (std::getline(file, line)) {
+            if (!Index<K, V>::parseLine(line, key, value)) {
+                continue;
+            }
+            batch.emplace_back(key, value);
+            bytes += sizeof(std::pair<K, V>) + heapBytes(key) + heapBytes(value);
+            if (bytes >= batchBytes) {
+                insertBatch(batch);
+                batch.clear();
+                bytes = 0;
+            }
+        }
+        insertBatch(batch);
+        return true;
+    }
+
+    // Remplace le contenu de l'index par un instantané (voir Index::saveSnapshot et
+    // ExternalBuilder), lu nœud par nœud : seul le nœud en cours de lecture s'ajoute au
+    // budget, quelle que soit la taille du fichier. Un instantané d'un autre type est refusé
+    // sans toucher à l'index ; s'il est tronqué, l'index garde les nœuds lus en entier.
+    bool loadSnapshot(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Erreur: Impossible d'ouvrir le fichier " << filename << std::endl;
+            return false;
+        }
+        uint64_t nbNodes;
+        if (!readSnapshotHeader<K, V>(file, nbNodes)) {
+            std::cerr << "Erreur: " << filename << " n'est pas un instantané de ce type d'index" << std::endl;
+            return false;
+        }
+        if (!snapshotNodesFit<K>(file, nbNodes)) {
+            std::cerr << "Erreur: Instantané tronqué ou corrompu " << filename << std::endl;
+            return false;
+        }
+
+        directory.clear();
+        lru.clear();
+        nbElements = 0;
+        residentBytes = 0;
+        openSpillFile();
+
+        std::vector<Element<K, V>*> elements;
+        K key;
+        V value;
+        uint64_t size;
+        for (uint64_t i = 0; i < nbNodes; ++i) {
+            if (!readBinary(file, key) || !readBinary(file, size)) {
+                std::cerr << "Erreur: Instantané tronqué " << filename << std::endl;
+                return false;
+            }
+            elements.clear();
+            for (uint64_t j = 0; j < size && readBinary(file, value); ++j) {
+                elements.push_back(new Element<K, V>(key, value));
+            }
+            if (elements.size() != size) {
+                for (auto* element : elements) {
+                    delete element;
+                }
+                std::cerr << "Erreur: Instantané tronqué " << filename << std::endl;
+                return false;
+            }
+            if (size > 0) {
+                // Clés croissantes : insertion en fin de répertoire
+                appendElements(directory.try_emplace(directory.end(), key), elements);
+                enforceBudget();
+            }
+        }
+        return true;
+    }
+
+    // Change le budget ; les nœuds en trop sont évincés aussitôt
+    void setMemoryBudget(size_t bytes) {
+        memoryBudget = bytes;
+        enforceBudget();
+    }
+
+    size_t getMemoryBudget() const {
+        return memoryBudget;
+    }
+
+    SpillStats getSpillStats() const {
+        SpillStats stats;
+        stats.hits = hits;
+        stats.misses = misses;
+        stats.evictions = evictions;
+        stats.spillWrites = spillWrites;
+        stats.compactions = compactions;
+        stats.residentNodes = lru.size();
+        stats.spilledNodes = directory.size() - lru.size();
+        stats.residentBytes = residentBytes;
+        stats.memoryBudget = memoryBudget;
+        stats.spillFileBytes = spillFileBytes;
+        stats.garbageBytes = garbageBytes;
+        return stats;
+    }
+};
+
+#endif // SPILLING_INDEX_H
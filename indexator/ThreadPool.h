@@ -0,0 +1,274 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Réserve de threads à vol de tâches (work stealing), partagée par tout le projet via
+// instance() : chargement, construction groupée et requêtes n'ont pas à créer leurs threads.
+// Chaque thread a sa propre file : il prend ses tâches par la fin (les plus récentes,
+// encore chaudes en cache) et, quand elle est vide, vole les plus anciennes au début de
+// la file d'un autre thread. Les tâches soumises depuis un thread de la réserve vont dans
+// sa propre file ; les autres sont réparties à tour de rôle.
+// Pour le parallélisme fork-join, voir TaskGroup et parallelFor.
+// Les tâches ne doivent pas lever d'exception.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // threads threads, éventuellement fixés chacun sur un cœur (Linux uniquement)
+    explicit ThreadPool(size_t threads = std::max(1u, std::thread::hardware_concurrency()),
+                        bool pinThreads = false) {
+        threads = std::max<size_t>(1, threads);
+        for (size_t i = 0; i < threads; ++i) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        for (size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([this, i, pinThreads]() {
+                if (pinThreads) {
+                    pinToCore(i);
+                }
+                workerLoop(i);
+            });
+        }
+    }
+
+    // Réserve globale, un thread par cœur
+    static ThreadPool& instance() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    // Destructeur : exécute les tâches restantes puis arrête les threads
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const {
+        return workers.size();
+    }
+
+    void submit(Task task) {
+        size_t target = currentPool == this
+            ? currentWorker
+            : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        pending.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(queues[target]->mutex);
+            queues[target]->tasks.push_back(std::move(task));
+        }
+        {
+            // Un thread qui vient de trouver pending nul est déjà en attente (pas de réveil perdu)
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wakeUp.notify_one();
+    }
+
+private:
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> pending{0};      // Tâches soumises et pas encore prises
+    std::atomic<size_t> nextQueue{0};
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    bool stopping = false;
+
+    // Réserve et numéro du thread courant, s'il appartient à une réserve
+    static inline thread_local ThreadPool* currentPool = nullptr;
+    static inline thread_local size_t currentWorker = 0;
+
+    static void pinToCore(size_t index) {
+#ifdef __linux__
+        unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(index % cores, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void)index;
+#endif
+    }
+
+    bool tryPop(size_t self, Task& task) {
+        {
+            Queue& own = *queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        return trySteal(self + 1, task);
+    }
+
+    // Vole la plus ancienne tâche d'une file, en commençant par la file from
+    bool trySteal(size_t from, Task& task) {
+        for (size_t i = 0; i < queues.size(); ++i) {
+            Queue& victim = *queues[(from + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(size_t self) {
+        currentPool = this;
+        currentWorker = self;
+        Task task;
+        while (true) {
+            if (tryPop(self, task)) {
+                pending.fetch_sub(1, std::memory_order_relaxed);
+                task();
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeUp.wait(lock, [this]() { return stopping || pending.load(std::memory_order_acquire) > 0; });
+            if (stopping && pending.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+        }
+    }
+};
+
+// Groupe de tâches fork-join : run() lance des sous-tâches, wait() attend leur fin en
+// exécutant lui-même celles du groupe qui n'ont pas encore démarré (utilisable depuis une
+// tâche de la réserve sans blocage). wait() n'exécute jamais la tâche d'un autre groupe :
+// l'appelant peut détenir un verrou que ces tâches prendraient.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::instance())
+        : pool(pool), state(std::make_shared<State>()) {}
+
+    ~TaskGroup() {
+        wait();
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    // La tâche est rangée dans la file du groupe ; la réserve reçoit seulement de quoi en
+    // prendre une, qui ne trouve plus rien si wait() l'a déjà exécutée
+    void run(ThreadPool::Task task) {
+        state->remaining.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->tasks.push_back(std::move(task));
+        }
+        pool.submit([state = state]() {
+            state->runOne();
+        });
+    }
+
+    void wait() {
+        while (state->remaining.load(std::memory_order_acquire) > 0) {
+            if (!state->runOne()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    // Partagé avec les tâches soumises à la réserve, qui peuvent survivre au groupe
+    struct State {
+        std::mutex mutex;
+        std::deque<ThreadPool::Task> tasks;
+        std::atomic<size_t> remaining{0};
+
+        bool runOne() {
+            ThreadPool::Task task;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (tasks.empty()) {
+                    return false;
+                }
+                task = std::move(tasks.back());
+                tasks.pop_back();
+            }
+            task();
+            remaining.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+    };
+
+    ThreadPool& pool;
+    std::shared_ptr<State> state;
+};
+
+// Appelle f(lo, hi) sur des tranches d'au plus grain indices couvrant [begin, end), en parallèle
+template <typename F>
+void parallelFor(size_t begin, size_t end, size_t grain, F f, ThreadPool& pool = ThreadPool::instance()) {
+    grain = std::max<size_t>(1, grain);
+    if (end <= begin + grain) {
+        if (begin < end) {
+            f(begin, end);
+        }
+        return;
+    }
+    TaskGroup group(pool);
+    for (size_t lo = begin; lo < end; lo += grain) {
+        size_t hi = std::min(end, lo + grain);
+        group.run([&f, lo, hi]() { f(lo, hi); });
+    }
+    group.wait();
+}
+
+// Tri stable parallèle : tranches triées en parallèle puis fusionnées deux à deux
+template <typename It, typename Compare>
+void parallelStableSort(It first, It last, Compare comp, size_t grain = 1 << 15,
+                        ThreadPool& pool = ThreadPool::instance()) {
+    size_t size = static_cast<size_t>(std::distance(first, last));
+    grain = std::max<size_t>(grain, (size + pool.size() * 4 - 1) / (pool.size() * 4));
+    if (size <= grain || pool.size() == 1) {
+        std::stable_sort(first, last, comp);
+        return;
+    }
+
+    parallelFor(0, size, grain, [&](size_t lo, size_t hi) {
+        std::stable_sort(first + lo, first + hi, comp);
+    }, pool);
+    for (size_t width = grain; width < size; width *= 2) {
+        parallelFor(0, (size + 2 * width - 1) / (2 * width), 1, [&](size_t lo, size_t hi) {
+            for (size_t pair = lo; pair < hi; ++pair) {
+                size_t begin = pair * 2 * width;
+                size_t middle = std::min(size, begin + width);
+                size_t end = std::min(size, begin + 2 * width);
+                std::inplace_merge(first + begin, first + middle, first + end, comp);
+            }
+        }, pool);
+    }
+}
+
+#endif // THREAD_POOL_H
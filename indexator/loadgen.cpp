@@ -0,0 +1,168 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include "Serialization.h"
+#include "IndexClient.h"
+
+// Générateur de charge du serveur d'index : envoie des GET aléatoires par lots de
+// --pipeline requêtes sans attendre, sur --connections connexions, et mesure le débit et
+// la durée des allers-retours.
+//   indexator-loadgen (--unix chemin | --tcp port) --index nom [--requests N]
+//                     [--pipeline P] [--connections C] [--keys K]
+
+struct LoadOptions {
+    std::string unixPath;
+    int tcpPort = -1;
+    std::string index;
+    size_t requests = 100000;   // Par connexion
+    size_t pipeline = 16;
+    size_t connections = 1;
+    uint32_t keys = 1000;       // Clés tirées dans [0, keys)
+};
+
+// Clé tirée, du type de l'index
+static void makeKey(uint32_t random, uint32_t keys, int& key) {
+    key = static_cast<int>(random % keys);
+}
+
+static void makeKey(uint32_t random, uint32_t, char& key) {
+    key = static_cast<char>('a' + random % 26);
+}
+
+static void makeKey(uint32_t random, uint32_t keys, std::string& key) {
+    key = std::to_string(random % keys);
+}
+
+static bool connectClient(IndexClient& client, const LoadOptions& options) {
+    bool connected = options.unixPath.empty() ? client.connectTcp(static_cast<uint16_t>(options.tcpPort))
+                                              : client.connectUnix(options.unixPath);
+    if (!connected) {
+        std::cerr << "Erreur: " << client.getLastError() << std::endl;
+    }
+    return connected;
+}
+
+// Une connexion : lots de GET, durée de chaque aller-retour en microsecondes dans roundTrips
+template <typename K>
+static bool runConnection(const LoadOptions& options, unsigned seed, std::vector<double>& roundTrips) {
+    IndexClient client;
+    if (!connectClient(client, options)) {
+        return false;
+    }
+    std::mt19937 random(seed);
+    K key;
+    Response response;
+    for (size_t sent = 0; sent < options.requests; sent += options.pipeline) {
+        size_t batch = std::min(options.pipeline, options.requests - sent);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < batch; ++i) {
+            makeKey(random(), options.keys, key);
+            client.request(Opcode::GET, options.index, key);
+        }
+        if (!client.flush()) {
+            std::cerr << "Erreur: " << client.getLastError() << std::endl;
+            return false;
+        }
+        for (size_t i = 0; i < batch; ++i) {
+            if (!client.receive(response) || response.status != ResponseStatus::OK) {
+                std::cerr << "Erreur: " << client.getLastError() << std::endl;
+                return false;
+            }
+        }
+        roundTrips.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    return true;
+}
+
+template <typename K>
+static bool runLoad(const LoadOptions& options) {
+    std::vector<std::vector<double>> roundTrips(options.connections);
+    std::vector<char> succeeded(options.connections, 0);
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < options.connections; ++i) {
+            threads.emplace_back([&, i]() {
+                succeeded[i] = runConnection<K>(options, static_cast<unsigned>(i + 1), roundTrips[i]) ? 1 : 0;
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (std::count(succeeded.begin(), succeeded.end(), 0) > 0) {
+        return false;
+    }
+
+    std::vector<double> all;
+    for (const auto& times : roundTrips) {
+        all.insert(all.end(), times.begin(), times.end());
+    }
+    std::sort(all.begin(), all.end());
+    size_t total = options.requests * options.connections;
+    std::cout << total << " requêtes en " << seconds * 1000.0 << " ms : "
+              << static_cast<size_t>(total / seconds) << " requêtes/s" << std::endl;
+    if (!all.empty()) {
+        std::cout << "Aller-retour d'un lot de " << options.pipeline << " : médiane "
+                  << all[all.size() / 2] << " µs, p99 " << all[static_cast<size_t>(0.99 * (all.size() - 1))]
+                  << " µs" << std::endl;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    LoadOptions options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string argument = argv[i];
+        std::string value = argv[i + 1];
+        if (argument == "--unix") {
+            options.unixPath = value;
+        } else if (argument == "--tcp") {
+            options.tcpPort = std::atoi(value.c_str());
+        } else if (argument == "--index") {
+            options.index = value;
+        } else if (argument == "--requests") {
+            options.requests = std::stoul(value);
+        } else if (argument == "--pipeline") {
+            options.pipeline = std::max<size_t>(1, std::stoul(value));
+        } else if (argument == "--connections") {
+            options.connections = std::max<size_t>(1, std::stoul(value));
+        } else if (argument == "--keys") {
+            options.keys = std::max<uint32_t>(1, static_cast<uint32_t>(std::stoul(value)));
+        }
+    }
+    if (options.index.empty() || (options.unixPath.empty() && options.tcpPort < 0)) {
+        std::cerr << "Usage: indexator-loadgen (--unix chemin | --tcp port) --index nom [--requests N]\n"
+                  << "                         [--pipeline P] [--connections C] [--keys K]" << std::endl;
+        return 1;
+    }
+
+    // Le type des clés à envoyer est celui de l'index
+    IndexClient client;
+    RemoteStats stats;
+    if (!connectClient(client, options)) {
+        return 1;
+    }
+    if (!client.stats(options.index, stats)) {
+        std::cerr << "Erreur: " << client.getLastError() << std::endl;
+        return 1;
+    }
+    std::cout << "Index « " << options.index << " » : " << stats.nbElements << " éléments, "
+              << stats.nbNodes << " nœuds" << std::endl;
+
+    bool ok = false;
+    if (stats.keyTag == BinaryTag<char>::value) {
+        ok = runLoad<char>(options);
+    } else if (stats.keyTag == BinaryTag<int>::value) {
+        ok = runLoad<int>(options);
+    } else if (stats.keyTag == BinaryTag<std::string>::value) {
+        ok = runLoad<std::string>(options);
+    }
+    return ok ? 0 : 1;
+}
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <string>
 #include <limits>
+#include <fstream>
+#include <chrono>
+#include <cstdlib>
 #include "Element.h"
 #include "Node.h"
 #include "Index.h"
@@ -12,8 +15,58 @@ void clearInputBuffer() {
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 }
 
+// Mode batch : indexator --batch [fichier|-] [--timing] [--offset N] [--limit N]
+// Exécute les commandes du fichier (ou de l'entrée standard) sans menu ni invite, voir
+// IndexManager::runBatch. Code de retour 1 si une commande a échoué.
+int runBatchMode(const std::string& filename, const BatchOptions& options) {
+    std::ios::sync_with_stdio(false);
+    IndexManager manager;
+    auto start = std::chrono::steady_clock::now();
+    int errors;
+    if (filename.empty() || filename == "-") {
+        errors = manager.runBatch(std::cin, std::cout, options);
+    } else {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Erreur: Impossible d'ouvrir le fichier " << filename << std::endl;
+            return 1;
+        }
+        errors = manager.runBatch(file, std::cout, options);
+    }
+    if (options.timing) {
+        std::cerr << "Durée totale : "
+                  << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+                  << " ms, " << errors << " erreur(s)" << std::endl;
+    }
+    return errors == 0 ? 0 : 1;
+}
+
 // Fonction principale avec menu interactif
-int main() {
+int main(int argc, char* argv[]) {
+    bool batch = false;
+    BatchOptions options;
+    std::string script;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--batch") {
+            batch = true;
+            if (i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0) {
+                script = argv[++i];
+            }
+        } else if (argument == "--timing") {
+            options.timing = true;
+        } else if ((argument == "--offset" || argument == "--limit") && i + 1 < argc) {
+            size_t value = std::strtoull(argv[++i], nullptr, 10);
+            (argument == "--offset" ? options.offset : options.limit) = value;
+        } else {
+            std::cerr << "Usage: indexator [--batch [fichier|-] [--timing] [--offset N] [--limit N]]" << std::endl;
+            return 1;
+        }
+    }
+    if (batch) {
+        return runBatchMode(script, options);
+    }
+
     IndexManager manager;
     int choice = 0;
     bool running = true;
@@ -22,6 +75,9 @@ int main() {
     std::cout << "=== INDEXATOR - Gestionnaire d'index ===" << std::endl;
 
     while (running) {
+        // Adopter un chargement terminé en arrière-plan avant toute opération
+        manager.adoptPendingLoad();
+
         std::cout << "\nMenu Principal:\n";
         std::cout << "1. Charger un index Char/String existant\n";
         std::cout << "2. Charger un index Int/String existant\n";
@@ -32,6 +88,20 @@ int main() {
         std::cout << "7. Supprimer un élément\n";
         std::cout << "8. Supprimer un nœud\n";
         std::cout << "9. Compter les éléments\n";
+        std::cout << "10. Afficher les statistiques\n";
+        std::cout << "11. Afficher l'avancement du chargement\n";
+        std::cout << "12. Annuler le chargement en cours\n";
+        std::cout << "13. Lister les index chargés\n";
+        std::cout << "14. Changer d'index actif\n";
+        std::cout << "15. Fermer un index\n";
+        std::cout << "16. Définir le budget mémoire\n";
+        std::cout << "17. Exécuter un lot de requêtes\n";
+        std::cout << "18. Définir la taille des pages d'affichage\n";
+        std::cout << "19. Enregistrer l'index courant dans un fichier\n";
+        std::cout << "20. Relire un fichier dans l'index courant (différences seulement)\n";
+        std::cout << "21. Charger tous les fichiers d'un répertoire\n";
+        std::cout << "22. Construire un instantané binaire depuis un gros fichier\n";
+        std::cout << "23. Charger un instantané binaire\n";
         std::cout << "0. Quitter\n";
         std::cout << "Votre choix: ";
         std::cin >> choice;
@@ -43,7 +113,7 @@ int main() {
                 std::getline(std::cin, filename);
 
                 if (manager.loadCharStringIndex(filename)) {
-                    std::cout << "Index Char/String chargé avec succès." << std::endl;
+                    std::cout << "Chargement de l'index Char/String lancé en arrière-plan." << std::endl;
                 } else {
                     std::cout << "Erreur lors du chargement de l'index." << std::endl;
                 }
@@ -55,7 +125,7 @@ int main() {
                 std::getline(std::cin, filename);
 
                 if (manager.loadIntStringIndex(filename)) {
-                    std::cout << "Index Int/String chargé avec succès." << std::endl;
+                    std::cout << "Chargement de l'index Int/String lancé en arrière-plan." << std::endl;
                 } else {
                     std::cout << "Erreur lors du chargement de l'index." << std::endl;
                 }
@@ -67,7 +137,7 @@ int main() {
                 std::getline(std::cin, filename);
 
                 if (manager.loadIntIntIndex(filename)) {
-                    std::cout << "Index Int/Int chargé avec succès." << std::endl;
+                    std::cout << "Chargement de l'index Int/Int lancé en arrière-plan." << std::endl;
                 } else {
                     std::cout << "Erreur lors du chargement de l'index." << std::endl;
                 }
@@ -118,6 +188,147 @@ int main() {
                 }
                 break;
 
+            case 10:  // Afficher les statistiques
+                if (manager.isIndexLoaded()) {
+                    manager.displayStats();
+                } else {
+                    std::cout << "Aucun index n'est chargé." << std::endl;
+                }
+                break;
+
+            case 11:  // Afficher l'avancement du chargement
+                manager.displayLoadProgress();
+                break;
+
+            case 12:  // Annuler le chargement en cours
+                if (manager.cancelLoad()) {
+                    std::cout << "Chargement annulé, l'index courant est conservé." << std::endl;
+                } else {
+                    std::cout << "Aucun chargement en cours." << std::endl;
+                }
+                break;
+
+            case 13:  // Lister les index chargés
+                manager.listIndexes();
+                break;
+
+            case 14: {  // Changer d'index actif
+                std::string name;
+                std::cout << "Entrez le nom de l'index à activer: ";
+                std::getline(std::cin, name);
+
+                if (manager.activateIndex(name)) {
+                    std::cout << "Index « " << name << " » activé." << std::endl;
+                } else {
+                    std::cout << "Index non trouvé." << std::endl;
+                }
+                break;
+            }
+
+            case 15: {  // Fermer un index
+                std::string name;
+                std::cout << "Entrez le nom de l'index à fermer: ";
+                std::getline(std::cin, name);
+
+                if (manager.removeIndex(name)) {
+                    std::cout << "Index « " << name << " » fermé." << std::endl;
+                } else {
+                    std::cout << "Index non trouvé ou actif." << std::endl;
+                }
+                break;
+            }
+
+            case 16: {  // Définir le budget mémoire
+                size_t budget;
+                std::cout << "Entrez le budget mémoire en octets (0 pour illimité): ";
+                std::cin >> budget;
+                clearInputBuffer();
+
+                manager.setMemoryBudget(budget);
+                std::cout << "Budget mémoire défini." << std::endl;
+                break;
+            }
+
+            case 17:  // Exécuter un lot de requêtes
+                std::cout << "Entrez le nom du fichier de requêtes: ";
+                std::getline(std::cin, filename);
+                manager.executeQueryBatch(filename);
+                break;
+
+            case 18: {  // Définir la taille des pages d'affichage
+                size_t size;
+                std::cout << "Entrez le nombre d'éléments par page (0 pour tout afficher): ";
+                std::cin >> size;
+                clearInputBuffer();
+
+                manager.setPageSize(size);
+                std::cout << "Taille des pages définie." << std::endl;
+                break;
+            }
+
+            case 19:  // Enregistrer l'index courant dans un fichier
+                std::cout << "Entrez le nom du fichier: ";
+                std::getline(std::cin, filename);
+                manager.saveCurrentIndex(filename);
+                break;
+
+            case 20:  // Relire un fichier dans l'index courant
+                std::cout << "Entrez le nom du fichier: ";
+                std::getline(std::cin, filename);
+                manager.reloadCurrentIndex(filename);
+                break;
+
+            case 21: {  // Charger tous les fichiers d'un répertoire
+                std::string type, answer;
+                size_t threads;
+                std::cout << "Entrez le chemin du répertoire: ";
+                std::getline(std::cin, filename);
+                std::cout << "Type d'index (cs, is ou ii): ";
+                std::getline(std::cin, type);
+                std::cout << "Nombre de threads (0 pour la valeur par défaut): ";
+                std::cin >> threads;
+                clearInputBuffer();
+                std::cout << "Fusionner en un seul index ? (o/n): ";
+                std::getline(std::cin, answer);
+
+                manager.loadDirectory(filename, type, threads, answer == "o");
+                break;
+            }
+
+            case 22: {  // Construire un instantané binaire depuis un gros fichier
+                std::string output, type;
+                size_t megabytes;
+                std::cout << "Entrez le nom du fichier texte: ";
+                std::getline(std::cin, filename);
+                std::cout << "Entrez le nom de l'instantané à créer: ";
+                std::getline(std::cin, output);
+                std::cout << "Type d'index (cs, is ou ii): ";
+                std::getline(std::cin, type);
+                std::cout << "Mémoire maximale en Mo: ";
+                std::cin >> megabytes;
+                clearInputBuffer();
+
+                manager.buildSnapshot(filename, output, type, megabytes);
+                break;
+            }
+
+            case 23: {  // Charger un instantané binaire
+                std::string type, name;
+                std::cout << "Entrez le nom de l'instantané à charger: ";
+                std::getline(std::cin, filename);
+                std::cout << "Type d'index (cs, is ou ii): ";
+                std::getline(std::cin, type);
+                std::cout << "Nom de l'index (vide pour le nom du fichier): ";
+                std::getline(std::cin, name);
+
+                if (manager.loadSnapshot(filename, type, name)) {
+                    std::cout << "Chargement de l'instantané lancé en arrière-plan." << std::endl;
+                } else {
+                    std::cout << "Erreur lors du chargement de l'instantané." << std::endl;
+                }
+                break;
+            }
+
             case 0:  // Quitter
                 std::cout << "Au revoir!" << std::endl;
                 running = false;
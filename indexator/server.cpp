@@ -0,0 +1,109 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <csignal>
+#include "Index.h"
+#include "IndexServer.h"
+#include "ThreadPool.h"
+
+// Serveur d'index : charge les fichiers donnés puis les sert en local (voir IndexServer)
+//   indexator-server [--unix chemin] [--tcp port] nom=type:fichier...
+// type : cs (Char/String), is (Int/String) ou ii (Int/Int).
+// Sans --unix ni --tcp, écoute sur la socket Unix /tmp/indexator.sock.
+
+static IndexServer* runningServer = nullptr;
+
+// SIGINT, SIGTERM : arrêt propre (stop() n'écrit que dans un eventfd)
+static void stopServer(int) {
+    if (runningServer != nullptr) {
+        runningServer->stop();
+    }
+}
+
+static void usage() {
+    std::cerr << "Usage: indexator-server [--unix chemin] [--tcp port] nom=type:fichier...\n"
+              << "  type : cs (Char/String), is (Int/String) ou ii (Int/Int)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    IndexServer server;
+    std::string unixPath;
+    int tcpPort = -1;
+    std::vector<std::function<bool()>> loads;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--unix" && i + 1 < argc) {
+            unixPath = argv[++i];
+        } else if (argument == "--tcp" && i + 1 < argc) {
+            tcpPort = std::atoi(argv[++i]);
+        } else {
+            size_t equal = argument.find('=');
+            size_t colon = argument.find(':', equal);
+            if (equal == std::string::npos || colon == std::string::npos || equal == 0) {
+                usage();
+                return 1;
+            }
+            std::string name = argument.substr(0, equal);
+            std::string type = argument.substr(equal + 1, colon - equal - 1);
+            std::string filename = argument.substr(colon + 1);
+
+            if (type == "cs") {
+                auto& index = server.addIndex<char, std::string>(name);
+                loads.push_back([&index, filename]() { return index.loadFromFile(filename); });
+            } else if (type == "is") {
+                auto& index = server.addIndex<int, std::string>(name);
+                loads.push_back([&index, filename]() { return index.loadFromFile(filename); });
+            } else if (type == "ii") {
+                auto& index = server.addIndex<int, int>(name);
+                loads.push_back([&index, filename]() { return index.loadFromFile(filename); });
+            } else {
+                usage();
+                return 1;
+            }
+        }
+    }
+    if (loads.empty()) {
+        usage();
+        return 1;
+    }
+
+    // Chargements en parallèle, chacun dans son propre index
+    std::vector<char> loaded(loads.size(), 0);
+    {
+        TaskGroup group;
+        for (size_t i = 0; i < loads.size(); ++i) {
+            group.run([&loads, &loaded, i]() { loaded[i] = loads[i]() ? 1 : 0; });
+        }
+    }
+    for (char ok : loaded) {
+        if (!ok) {
+            return 1;
+        }
+    }
+
+    if (unixPath.empty() && tcpPort < 0) {
+        unixPath = "/tmp/indexator.sock";
+    }
+    if (!unixPath.empty()) {
+        if (!server.listenUnix(unixPath)) {
+            return 1;
+        }
+        std::cout << "Écoute sur " << unixPath << std::endl;
+    }
+    if (tcpPort >= 0) {
+        if (!server.listenTcp(static_cast<uint16_t>(tcpPort))) {
+            return 1;
+        }
+        std::cout << "Écoute sur 127.0.0.1:" << server.getTcpPort() << std::endl;
+    }
+
+    runningServer = &server;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+    server.run();
+    runningServer = nullptr;
+    std::cout << "Serveur arrêté." << std::endl;
+    return 0;
+}
@@ -0,0 +1,786 @@
+// test_concurrent_index.cpp
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include "Element.h"
+#include "Index.h"
+#include "ConcurrentIndex.h"
+#include "RcuIndex.h"
+#include "ShardedIndex.h"
+#include "ThreadPool.h"
+#include "QueryExecutor.h"
+#include "AsyncIndex.h"
+#include <fstream>
+#include <future>
+#include <cstdio>
+#include <sstream>
+#include <random>
+
+// Fonction utilitaire pour vérifier les assertions
+#define TEST_ASSERT(condition, message) \
+    if (!(condition)) { \
+        std::cerr << "ÉCHEC: " << message << " (" << __FILE__ << ":" << __LINE__ << ")" << std::endl; \
+        exit(1); \
+    } else { \
+        std::cout << "SUCCÈS: " << message << std::endl; \
+    }
+
+// Lecteurs et rédacteurs simultanés : les lectures restent cohérentes
+void testConcurrentIndexStress() {
+    std::cout << "\n=== Test ConcurrentIndex : lecteurs et rédacteurs simultanés ===\n";
+
+    const int nbKeys = 64;
+    const int nbWriters = 4;
+    const int opsPerWriter = 20000;
+
+    ConcurrentIndex<int, int> index;
+    std::atomic<bool> stop{false};
+    std::atomic<bool> readsConsistent{true};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&, r]() {
+            int key = r;
+            while (!stop) {
+                auto elements = index.getElements(key);
+                bool sorted = std::is_sorted(elements.begin(), elements.end(),
+                                             [](const Element<int, int>& a, const Element<int, int>& b) {
+                                                 return a.getValue() < b.getValue();
+                                             });
+                bool sameKey = std::all_of(elements.begin(), elements.end(),
+                                           [key](const Element<int, int>& e) { return e.getKey() == key; });
+                if (!sorted || !sameKey) {
+                    readsConsistent = false;
+                }
+                key = (key + 7) % nbKeys;
+            }
+        });
+    }
+
+    // Les instantanés pris pendant les écritures restent cohérents
+    std::atomic<bool> snapshotsConsistent{true};
+    std::thread snapshotter([&]() {
+        while (!stop) {
+            auto snapshot = index.snapshot();
+            IndexStats stats = snapshot->getStats();
+            if (stats.nbElements != snapshot->getNbElements()) {
+                snapshotsConsistent = false;
+            }
+        }
+    });
+
+    // Chaque rédacteur ajoute des valeurs qui lui sont propres, puis en supprime la moitié
+    std::vector<std::thread> writers;
+    for (int w = 0; w < nbWriters; ++w) {
+        writers.emplace_back([&, w]() {
+            for (int i = 0; i < opsPerWriter; ++i) {
+                index.addElement(i % nbKeys, w * opsPerWriter + i);
+            }
+            for (int i = 0; i < opsPerWriter; i += 2) {
+                index.deleteElement(Element<int, int>(i % nbKeys, w * opsPerWriter + i));
+            }
+        });
+    }
+
+    for (auto& writer : writers) writer.join();
+    stop = true;
+    for (auto& reader : readers) reader.join();
+    snapshotter.join();
+
+    TEST_ASSERT(readsConsistent, "Les lectures concurrentes voient des nœuds cohérents");
+    TEST_ASSERT(snapshotsConsistent, "Les instantanés concurrents sont cohérents");
+    TEST_ASSERT(index.getNbElements() == nbWriters * opsPerWriter / 2, "Le nombre d'éléments final est exact");
+    TEST_ASSERT(index.getStats().nbElements == index.getNbElements(), "Les statistiques sont cohérentes");
+
+    // Vider des nœuds en parallèle fait passer par le verrou exclusif du répertoire
+    std::vector<std::thread> cleaners;
+    for (int w = 0; w < nbWriters; ++w) {
+        cleaners.emplace_back([&, w]() {
+            for (int i = 1; i < opsPerWriter; i += 2) {
+                index.deleteElement(Element<int, int>(i % nbKeys, w * opsPerWriter + i));
+            }
+        });
+    }
+    for (auto& cleaner : cleaners) cleaner.join();
+    TEST_ASSERT(index.getNbElements() == 0 && index.getNbNodes() == 0, "Les nœuds vidés sont retirés");
+
+    // Relecture différentielle : l'instantané pris avant garde l'ancien contenu
+    index.loadFromFile("exemple_index/complexe-nombres.txt");
+    auto before = index.snapshot();
+    Index<int, int> expected;
+    expected.loadFromFile("exemple_index/simples-nombres.txt");
+    ReloadSummary<int> summary;
+    TEST_ASSERT(index.reloadFromFile("exemple_index/simples-nombres.txt", &summary)
+                && index.getNbElements() == expected.getNbElements()
+                && summary.added - summary.removed == expected.getNbElements() - before->getNbElements()
+                && before->getNbElements() != expected.getNbElements(), "Relecture différentielle sous verrou");
+}
+
+// Débit de lecture selon le nombre de threads (un rédacteur en parallèle)
+// Chargement par échange : les réglages de l'index restent, sa version avance
+void testConcurrentReload() {
+    std::cout << "\n=== Test ConcurrentIndex : chargement d'un fichier ===\n";
+
+    const std::string path = "/tmp/indexator-test-concurrent-reload.txt";
+    {
+        std::ofstream file(path);
+        for (int i = 0; i < 1000; ++i) {
+            file << i % 100 << " ; " << i << "\n";
+        }
+    }
+
+    ConcurrentIndex<int, int> index;
+    index.setLazyDeletion(true, 0.5);
+    for (int i = 0; i < 50; ++i) {
+        index.addElement(i, i);
+    }
+    index.deleteElement(Element<int, int>(3, 3));
+    uint64_t before = index.getVersion();
+
+    TEST_ASSERT(index.loadFromFile(path), "Fichier chargé");
+    TEST_ASSERT(index.isLazyDeletion(), "La suppression paresseuse reste active");
+    TEST_ASSERT(index.getVersion() > before, "La version avance");
+    TEST_ASSERT(index.getNbElements() == 1000 && index.getNbNodes() == 100 && index.getNbDeleted() == 0,
+                "Contenu du fichier");
+
+    TEST_ASSERT(index.deleteElement(Element<int, int>(5, 105)) && index.getNbDeleted() == 1,
+                "Suppression marquée après le chargement");
+    std::remove(path.c_str());
+}
+
+void measureReadThroughput() {
+    std::cout << "\n=== Débit de lecture ConcurrentIndex ===\n";
+
+    ConcurrentIndex<int, int> index;
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < 100000; ++i) {
+        data.emplace_back(i % 10000, i);
+    }
+    index.insertBatch(data);
+
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        std::atomic<bool> stop{false};
+        std::atomic<long> reads{0};
+
+        std::thread writer([&]() {
+            int i = 0;
+            while (!stop) {
+                index.addElement(i % 10000, -i);
+                index.deleteElement(Element<int, int>(i % 10000, -i));
+                ++i;
+            }
+        });
+
+        std::vector<std::thread> readers;
+        for (unsigned t = 0; t < threads; ++t) {
+            readers.emplace_back([&, t]() {
+                long local = 0;
+                int key = t;
+                while (!stop) {
+                    local += index.getElements(key).empty() ? 0 : 1;
+                    key = (key + 7919) % 10000;
+                }
+                reads += local;
+            });
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        stop = true;
+        for (auto& reader : readers) reader.join();
+        writer.join();
+
+        std::cout << threads << " lecteur(s) : " << reads * 5 << " lectures/s" << std::endl;
+    }
+}
+
+// Lecteurs sans verrou pendant des insertions : chaque lecture voit une version cohérente
+void testRcuIndex() {
+    std::cout << "\n=== Test RcuIndex : lectures sans verrou ===\n";
+
+    const int nbKeys = 32;
+    RcuIndex<int, int> index;
+    std::atomic<bool> stop{false};
+    std::atomic<bool> readsConsistent{true};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&, r]() {
+            int key = r;
+            while (!stop) {
+                index.visitElements(key, [&](const std::vector<Element<int, int>>& elements) {
+                    bool sorted = std::is_sorted(elements.begin(), elements.end(),
+                                                 [](const Element<int, int>& a, const Element<int, int>& b) {
+                                                     return a.getValue() < b.getValue();
+                                                 });
+                    if (!sorted || elements.empty() || elements.front().getKey() != key) {
+                        readsConsistent = false;
+                    }
+                });
+                key = (key + 5) % nbKeys;
+            }
+        });
+    }
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; ++w) {
+        writers.emplace_back([&, w]() {
+            for (int i = 0; i < 5000; ++i) {
+                index.addElement(i % nbKeys, w * 5000 + i);
+            }
+            std::vector<std::pair<int, int>> batch;
+            for (int i = 0; i < 1000; ++i) {
+                batch.emplace_back(i % nbKeys, -(w * 1000 + i) - 1);
+            }
+            index.insertBatch(batch);
+            for (int i = 0; i < 5000; i += 2) {
+                index.deleteElement(Element<int, int>(i % nbKeys, w * 5000 + i));
+            }
+        });
+    }
+
+    for (auto& writer : writers) writer.join();
+    stop = true;
+    for (auto& reader : readers) reader.join();
+
+    TEST_ASSERT(readsConsistent, "Les lecteurs voient toujours des nœuds cohérents");
+    TEST_ASSERT(index.getNbElements() == 2 * 2500 + 2 * 1000, "Le nombre d'éléments final est exact");
+    size_t visited = 0;
+    index.visitElements(3, [&visited](const std::vector<Element<int, int>>& elements) { visited = elements.size(); });
+    TEST_ASSERT(visited > 0 && index.getElements(3).size() == visited, "getElements retourne une copie complète du nœud");
+
+    TEST_ASSERT(index.deleteNode(3) && !index.contains(3), "deleteNode retire le nœud");
+    EpochDomain::instance().collect();
+    TEST_ASSERT(EpochDomain::instance().pendingCount() == 0, "Les anciennes versions sont libérées sans lecteur actif");
+
+    // Grand répertoire : chaque écriture en retire une copie de plusieurs centaines de Ko,
+    // la collecte suit les octets en attente et non le seul nombre de copies
+    RcuIndex<int, int> large;
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < 50000; ++i) {
+        pairs.emplace_back(i, i);
+    }
+    large.insertBatch(pairs);
+    size_t directoryBytes = 50000 * sizeof(void*);
+    size_t maxPending = 0;
+    for (int i = 0; i < 200; ++i) {
+        large.addElement(i, -i);
+        maxPending = std::max(maxPending, EpochDomain::instance().pendingBytes());
+    }
+    TEST_ASSERT(maxPending >= directoryBytes && maxPending < EpochDomain::CollectBytes + 2 * directoryBytes,
+                "Copies retirées bornées par CollectBytes");
+    EpochDomain::instance().collect();
+    TEST_ASSERT(EpochDomain::instance().pendingBytes() == 0, "Octets en attente remis à zéro après collecte");
+}
+
+// Débit de lecture de RcuIndex selon le nombre de threads (un rédacteur en parallèle)
+void measureRcuReadThroughput() {
+    std::cout << "\n=== Débit de lecture RcuIndex ===\n";
+
+    RcuIndex<int, int> index;
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < 100000; ++i) {
+        data.emplace_back(i % 10000, i);
+    }
+    index.insertBatch(data);
+
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        std::atomic<bool> stop{false};
+        std::atomic<long> reads{0};
+
+        std::thread writer([&]() {
+            int i = 0;
+            while (!stop) {
+                index.addElement(i % 10000, -i);
+                index.deleteElement(Element<int, int>(i % 10000, -i));
+                ++i;
+            }
+        });
+
+        std::vector<std::thread> readers;
+        for (unsigned t = 0; t < threads; ++t) {
+            readers.emplace_back([&, t]() {
+                long local = 0;
+                int key = t;
+                while (!stop) {
+                    local += index.visitElements(key, [](const std::vector<Element<int, int>>&) {}) ? 1 : 0;
+                    key = (key + 7919) % 10000;
+                }
+                reads += local;
+            });
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        stop = true;
+        for (auto& reader : readers) reader.join();
+        writer.join();
+
+        std::cout << threads << " lecteur(s) : " << reads * 5 << " lectures/s" << std::endl;
+    }
+}
+
+// Index réparti : mêmes résultats qu'un Index unique
+void testShardedIndex() {
+    std::cout << "\n=== Test ShardedIndex ===\n";
+
+    Index<int, std::string> reference;
+    TEST_ASSERT(reference.loadFromFile("exemple_index/complexe-notes.txt"), "Chargement de référence");
+
+    ShardedIndex<int, std::string> sharded(4);
+    TEST_ASSERT(sharded.loadFromFile("exemple_index/complexe-notes.txt", 3), "Chargement réparti");
+    TEST_ASSERT(sharded.getNbElements() == reference.getNbElements()
+                && sharded.getNbNodes() == reference.getNbNodes(), "Mêmes compteurs que l'index unique");
+
+    std::ostringstream expected, actual;
+    expected << reference;
+    actual << sharded;
+    TEST_ASSERT(expected.str() == actual.str(), "L'affichage fusionne les shards dans l'ordre des clés");
+
+    auto range = sharded.getRange(5, 8);
+    auto referenceRange = reference.getRange(5, 8);
+    bool sameRange = range.size() == referenceRange.size();
+    for (size_t i = 0; sameRange && i < range.size(); ++i) {
+        sameRange = range[i] == *referenceRange[i];
+    }
+    TEST_ASSERT(sameRange, "getRange fusionne les shards dans l'ordre");
+
+    // Fichier de plusieurs blocs : les lignes à cheval sur deux blocs ne sont pas perdues
+    const std::string bigFile = "/tmp/indexator-test-sharded.txt";
+    {
+        std::ofstream file(bigFile);
+        for (long long i = 0; i < 600000; ++i) {
+            file << i * 7919 % 10007 << " ; " << i << "\n";
+        }
+        file << "ligne invalide\n";
+    }
+    Index<int, int> bigReference;
+    ShardedIndex<int, int> bigSharded(4);
+    TEST_ASSERT(bigReference.loadFromFile(bigFile) && bigSharded.loadFromFile(bigFile, 3)
+                && bigSharded.getNbElements() == 600000 && bigSharded.getNbNodes() == bigReference.getNbNodes()
+                && bigSharded.getElements(0).size() == bigReference.getElements(0).size(),
+                "Chargement par blocs : mêmes compteurs que l'index unique");
+    std::remove(bigFile.c_str());
+
+    // Insertions parallèles depuis plusieurs threads
+    ShardedIndex<int, int> parallel(8);
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 4; ++w) {
+        writers.emplace_back([&parallel, w]() {
+            std::vector<std::pair<int, int>> batch;
+            for (int i = 0; i < 5000; ++i) {
+                batch.emplace_back(i % 500, w * 5000 + i);
+            }
+            parallel.insertBatch(batch);
+            for (int i = 0; i < 100; ++i) {
+                parallel.addElement(1000 + i, w);
+            }
+        });
+    }
+    for (auto& writer : writers) writer.join();
+    TEST_ASSERT(parallel.getNbElements() == 4 * 5100 && parallel.getNbNodes() == 600,
+                "Les insertions parallèles sont toutes appliquées");
+    TEST_ASSERT(parallel.getElements(7).size() == 40, "Les éléments d'une clé sont dans un seul shard");
+}
+
+// Réserve à vol de tâches : toutes les tâches, y compris imbriquées, sont exécutées
+void testThreadPool() {
+    std::cout << "\n=== Test ThreadPool ===\n";
+
+    std::atomic<int> executed{0};
+    {
+        ThreadPool pool(4);
+        for (int i = 0; i < 1000; ++i) {
+            pool.submit([&pool, &executed]() {
+                ++executed;
+                pool.submit([&executed]() { ++executed; });
+            });
+        }
+    }
+    TEST_ASSERT(executed == 2000, "Les tâches soumises et imbriquées sont toutes exécutées");
+}
+
+// Exécuteur de requêtes : mêmes résultats qu'en séquentiel, sur une version figée
+void testQueryExecutor() {
+    std::cout << "\n=== Test QueryExecutor ===\n";
+
+    Index<int, int> index;
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < 50000; ++i) {
+        data.emplace_back(i % 5000, i);
+    }
+    index.insertBatch(data);
+
+    std::vector<Query<int>> queries;
+    for (int i = 0; i < 3000; ++i) {
+        Query<int> query;
+        query.type = static_cast<Query<int>::Type>(i % 3);
+        query.lo = (i * 7919) % 5000;
+        query.hi = query.lo + i % 20;
+        queries.push_back(query);
+    }
+
+    auto view = index.snapshot();
+    index.deleteRange(0, 2500);   // Ne doit pas être vu par le lot
+
+    ThreadPool pool(4);
+    QueryExecutor<int, int> executor(pool, 16);
+    BatchResult<int, int> batch = executor.execute(view, queries);
+
+    bool same = batch.results.size() == queries.size();
+    for (size_t i = 0; same && i < queries.size(); ++i) {
+        const Query<int>& query = queries[i];
+        const QueryResult<int, int>& result = batch.results[i];
+        switch (query.type) {
+            case Query<int>::Type::GET:
+                same = result.count == 10 && result.elements.size() == 10
+                       && result.elements.front()->getKey() == query.lo;
+                break;
+            case Query<int>::Type::COUNT:
+                same = result.count == 10 * (std::min(query.hi, 4999) - query.lo + 1);
+                break;
+            case Query<int>::Type::RANGE:
+                same = result.count == view->countRange(query.lo, query.hi)
+                       && std::is_sorted(result.elements.begin(), result.elements.end(),
+                                         [](const Element<int, int>* a, const Element<int, int>* b) { return *a < *b; });
+                break;
+        }
+    }
+    TEST_ASSERT(same, "Résultats dans l'ordre de soumission, sur la version de l'instantané");
+    TEST_ASSERT(batch.latencyMs > 0.0, "Latence du lot mesurée");
+
+    using IntExecutor = QueryExecutor<int, int>;
+    Query<int> parsed;
+    TEST_ASSERT(IntExecutor::parseQuery("range 3 8", parsed) && parsed.type == Query<int>::Type::RANGE
+                && parsed.lo == 3 && parsed.hi == 8, "Analyse d'une requête range");
+    TEST_ASSERT(IntExecutor::parseQuery("count 4", parsed) && parsed.hi == 4, "count sans borne haute");
+    TEST_ASSERT(!IntExecutor::parseQuery("get", parsed) && !IntExecutor::parseQuery("# get 1", parsed)
+                && !IntExecutor::parseQuery("put 1 2", parsed), "Requêtes invalides refusées");
+
+    // Latence selon le nombre de threads
+    for (size_t threads = 1; threads <= std::max(1u, std::thread::hardware_concurrency()); threads *= 2) {
+        ThreadPool sized(threads);
+        QueryExecutor<int, int> timed(sized);
+        std::cout << threads << " thread(s) : " << timed.execute(view, queries).latencyMs << " ms" << std::endl;
+    }
+}
+
+// Fork-join : groupes imbriqués, parallelFor et tri stable parallèle
+void testForkJoin() {
+    std::cout << "\n=== Test TaskGroup / parallelFor / parallelStableSort ===\n";
+
+    ThreadPool pool(4);
+    std::atomic<long> sum{0};
+    {
+        TaskGroup outer(pool);
+        for (int i = 0; i < 8; ++i) {
+            outer.run([&pool, &sum, i]() {
+                // Attente imbriquée depuis un thread de la réserve
+                TaskGroup inner(pool);
+                for (int j = 0; j < 100; ++j) {
+                    inner.run([&sum, i, j]() { sum += i * 100 + j; });
+                }
+                inner.wait();
+            });
+        }
+    }
+    TEST_ASSERT(sum == 799 * 800 / 2, "Les groupes imbriqués se terminent sans blocage");
+
+    std::vector<int> values(100000);
+    parallelFor(0, values.size(), 1000, [&values](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) values[i] = static_cast<int>(i);
+    }, pool);
+    TEST_ASSERT(std::accumulate(values.begin(), values.end(), 0L) == 99999L * 100000 / 2, "parallelFor couvre tous les indices");
+
+    // Paires (clé, rang d'origine) : le tri sur la clé seule doit conserver l'ordre des rangs
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < 200000; ++i) {
+        pairs.emplace_back((i * 7919) % 1000, i);
+    }
+    auto expected = pairs;
+    auto byKey = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+    std::stable_sort(expected.begin(), expected.end(), byKey);
+    parallelStableSort(pairs.begin(), pairs.end(), byKey, 1000, pool);
+    TEST_ASSERT(pairs == expected, "Le tri parallèle est stable");
+
+    // wait() n'exécute que les tâches de son groupe : le seul thread de la réserve est
+    // bloqué, une tâche étrangère attend dans sa file
+    ThreadPool single(1);
+    std::atomic<bool> release{false}, foreignRan{false};
+    std::thread::id foreignThread;
+    single.submit([&release]() {
+        while (!release) std::this_thread::yield();
+    });
+    single.submit([&foreignRan, &foreignThread]() {
+        foreignThread = std::this_thread::get_id();
+        foreignRan = true;
+    });
+    {
+        TaskGroup group(single);
+        std::atomic<int> own{0};
+        for (int i = 0; i < 4; ++i) {
+            group.run([&own]() { ++own; });
+        }
+        group.wait();
+        TEST_ASSERT(own == 4 && !foreignRan, "wait() exécute ses tâches sans prendre celles des autres");
+    }
+    release = true;
+    while (!foreignRan) std::this_thread::yield();
+    TEST_ASSERT(foreignThread != std::this_thread::get_id(), "La tâche étrangère reste à la réserve");
+
+    // Gros lots simultanés : le tri parallèle de chaque shard s'attend sous le verrou du shard
+    ShardedIndex<int, int> sharded(4);
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; ++w) {
+        writers.emplace_back([&sharded, w]() {
+            std::vector<std::pair<int, int>> batch;
+            for (int i = 0; i < 400000; ++i) {
+                batch.emplace_back(static_cast<int>(i * 7919LL % 50000), w);
+            }
+            sharded.insertBatch(batch);
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    TEST_ASSERT(sharded.getNbElements() == 800000, "Gros lots simultanés sur un ShardedIndex sans blocage");
+}
+
+// Coût de création des tâches et passage à l'échelle du tri parallèle
+void measureThreadPool() {
+    std::cout << "\n=== Mesures ThreadPool ===\n";
+
+    const int nbTasks = 100000;
+    {
+        ThreadPool pool;
+        std::atomic<int> done{0};
+        auto start = std::chrono::steady_clock::now();
+        {
+            TaskGroup group(pool);
+            for (int i = 0; i < nbTasks; ++i) {
+                group.run([&done]() { ++done; });
+            }
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Création et exécution d'une tâche vide : " << ns / nbTasks << " ns" << std::endl;
+    }
+
+    std::vector<Element<int, int>*> elements;
+    for (int i = 0; i < 1000000; ++i) {
+        elements.push_back(new Element<int, int>(static_cast<int>((i * 7919LL) % 100000), i));
+    }
+    auto less = [](const Element<int, int>* a, const Element<int, int>* b) { return *a < *b; };
+    for (size_t threads = 1; threads <= std::max(1u, std::thread::hardware_concurrency()); threads *= 2) {
+        ThreadPool pool(threads);
+        auto shuffled = elements;
+        auto start = std::chrono::steady_clock::now();
+        parallelStableSort(shuffled.begin(), shuffled.end(), less, 1 << 15, pool);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Tri de " << elements.size() << " éléments, " << threads << " thread(s) : " << ms << " ms" << std::endl;
+    }
+    for (auto* element : elements) {
+        delete element;
+    }
+}
+
+// Interface asynchrone : mêmes résultats que l'index, par futures et par rappels
+void testAsyncIndex() {
+    std::cout << "\n=== Test AsyncIndex ===\n";
+
+    using Async = AsyncIndex<int, int>;
+    ThreadPool pool(4);
+    Async async(pool, 32);
+    Index<int, int> reference;
+
+    std::vector<Async::Mutation> mutations;
+    for (int i = 0; i < 5000; ++i) {
+        mutations.push_back({Async::Mutation::Type::ADD, i % 500, i});
+        reference.addElement(new Element<int, int>(i % 500, i));
+    }
+    mutations.push_back({Async::Mutation::Type::REMOVE, 3, 3});
+    mutations.push_back({Async::Mutation::Type::REMOVE, 3, -1});   // Absent
+    mutations.push_back({Async::Mutation::Type::REMOVE_NODE, 4, 0});
+    Element<int, int> removed(3, 3);
+    reference.deleteElement(&removed);
+    reference.deleteNode(4);
+
+    Async::MutationSummary summary = async.applyAsync(mutations).get();
+    TEST_ASSERT(summary.added == 5000 && summary.removed == 11 && summary.nodesRemoved == 1, "Bilan du lot de modifications");
+    TEST_ASSERT(async.index().getNbElements() == reference.getNbElements(), "Le lot est entièrement appliqué");
+
+    std::vector<Element<int, int>> got = async.getAsync(7).get();
+    TEST_ASSERT(got.size() == 10 && got.front().getKey() == 7, "getAsync par future");
+
+    std::vector<Element<int, int>> range = async.rangeAsync(100, 300).get();
+    std::vector<Element<int, int>*> expected = reference.getRange(100, 300);
+    bool same = range.size() == expected.size();
+    for (size_t i = 0; same && i < range.size(); ++i) {
+        same = range[i] == *expected[i];
+    }
+    TEST_ASSERT(same, "rangeAsync parcourt l'intervalle par morceaux, dans l'ordre");
+    TEST_ASSERT(async.rangeAsync(300, 100).get().empty() && async.rangeAsync(600, 700).get().empty(), "Intervalles vides");
+
+    std::promise<size_t> callback;
+    async.rangeAsync(0, 499, [&callback](std::vector<Element<int, int>> elements) {
+        callback.set_value(elements.size());
+    });
+    TEST_ASSERT(callback.get_future().get() == static_cast<size_t>(reference.getNbElements()), "rangeAsync par rappel");
+
+    TEST_ASSERT(async.loadAsync("exemple_index/simples-nombres.txt").get(), "loadAsync par future");
+    TEST_ASSERT(!async.loadAsync("exemple_index/inexistant.txt").get(), "Échec de chargement signalé");
+    TEST_ASSERT(async.index().getNbElements() > 0 && !async.index().contains(499), "L'index chargé remplace le précédent");
+
+    // Destruction pendant que l'unique thread de la réserve est occupé : le destructeur
+    // exécute lui-même les opérations en cours, jamais la tâche d'un autre utilisateur
+    ThreadPool single(1);
+    std::atomic<bool> release{false}, foreignRan{false};
+    single.submit([&release]() {
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+    single.submit([&foreignRan]() { foreignRan = true; });
+    std::atomic<size_t> scanned{0};
+    {
+        Async pending(single, 8);
+        pending.index().insertBatch(std::vector<std::pair<int, int>>{{1, 1}, {2, 2}, {3, 3}});
+        pending.rangeAsync(0, 9, [&scanned](std::vector<Element<int, int>> elements) { scanned = elements.size(); });
+    }
+    TEST_ASSERT(scanned == 3 && !foreignRan, "Destructeur : opérations terminées, tâches étrangères laissées à la réserve");
+    release = true;
+}
+
+// La boucle d'événements reste réactive pendant un chargement et un long parcours :
+// écart maximal entre deux tours (1 ms prévue) pendant l'attente
+void measureAsyncLatency() {
+    std::cout << "\n=== Latence de la boucle d'événements avec AsyncIndex ===\n";
+
+    const std::string path = "/tmp/indexator-test-async.txt";
+    {
+        std::ofstream file(path);
+        for (int i = 0; i < 300000; ++i) {
+            file << (i * 7919LL) % 100000 << " ; " << i << "\n";
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        Index<int, int> blocking;
+        blocking.loadFromFile(path);
+    }
+    double synchronousMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    AsyncIndex<int, int> async;
+    // Tours de boucle jusqu'à ce que le future soit prêt ; retourne l'écart maximal en ms
+    auto runLoop = [](auto& future) {
+        double maxGap = 0.0;
+        auto last = std::chrono::steady_clock::now();
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            auto now = std::chrono::steady_clock::now();
+            maxGap = std::max(maxGap, std::chrono::duration<double, std::milli>(now - last).count());
+            last = now;
+        }
+        return maxGap;
+    };
+
+    start = std::chrono::steady_clock::now();
+    std::future<bool> loaded = async.loadAsync(path);
+    double loadGap = runLoop(loaded);
+    double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    TEST_ASSERT(loaded.get() && async.index().getNbElements() == 300000, "Chargement asynchrone terminé");
+
+    start = std::chrono::steady_clock::now();
+    auto scanned = async.rangeAsync(0, 99999);
+    double rangeGap = runLoop(scanned);
+    double rangeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    TEST_ASSERT(scanned.get().size() == 300000, "Parcours asynchrone terminé");
+
+    std::cout << "Chargement synchrone : boucle bloquée " << synchronousMs << " ms" << std::endl;
+    std::cout << "Chargement asynchrone : " << loadMs << " ms, écart maximal entre deux tours " << loadGap << " ms" << std::endl;
+    std::cout << "Parcours asynchrone : " << rangeMs << " ms, écart maximal entre deux tours " << rangeGap << " ms" << std::endl;
+    TEST_ASSERT(loadGap < 100.0 && rangeGap < 100.0, "La boucle d'événements n'est pas bloquée");
+    std::remove(path.c_str());
+}
+
+// Latence des suppressions, paresseuses ou immédiates : médiane, 99e centile et maximum
+void measureDeleteLatency() {
+    std::cout << "\n=== Latence des suppressions ConcurrentIndex ===\n";
+
+    const int nbKeys = 20000, perKey = 16;
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < nbKeys * perKey; ++i) {
+        data.emplace_back(i % nbKeys, i);
+    }
+    std::vector<std::pair<int, int>> order = data;
+    std::mt19937 random(11);
+    std::shuffle(order.begin(), order.end(), random);
+
+    for (bool lazy : {false, true}) {
+        ConcurrentIndex<int, int> index;
+        index.setLazyDeletion(lazy);
+        index.insertBatch(data);
+
+        std::atomic<bool> stop{false};
+        std::atomic<long> reads{0};
+        std::thread reader([&]() {
+            long local = 0;
+            for (int key = 0; !stop; key = (key + 7919) % nbKeys) {
+                local += static_cast<long>(index.getElements(key).size());
+            }
+            reads += local;
+        });
+
+        std::vector<double> latencies;
+        latencies.reserve(order.size());
+        bool allDeleted = true;
+        size_t checked = 0;
+        bool exactCount = true;
+        for (const auto& pair : order) {
+            auto start = std::chrono::steady_clock::now();
+            allDeleted = index.deleteElement(Element<int, int>(pair.first, pair.second)) && allDeleted;
+            latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            ++checked;
+            if (checked % 40000 == 0) {
+                exactCount = exactCount && index.getNbElements() == static_cast<int>(order.size() - checked);
+            }
+        }
+        stop = true;
+        reader.join();
+
+        TEST_ASSERT(allDeleted && exactCount && index.getNbElements() == 0 && index.getNbNodes() == 0,
+                    std::string(lazy ? "Paresseuse" : "Immédiate") + " : toutes les suppressions faites, compte exact");
+        std::sort(latencies.begin(), latencies.end());
+        double total = std::accumulate(latencies.begin(), latencies.end(), 0.0);
+        std::cout << (lazy ? "Paresseuse" : "Immédiate") << " : " << latencies.size() << " suppressions en "
+                  << total / 1000.0 << " ms ; p50 " << latencies[latencies.size() / 2] << " µs, p99 "
+                  << latencies[latencies.size() * 99 / 100] << " µs, max " << latencies.back() << " µs ("
+                  << reads << " éléments lus en parallèle)" << std::endl;
+    }
+}
+
+int main() {
+    std::cout << "=== Programme de test pour les index concurrents ===\n";
+
+    testConcurrentIndexStress();
+    testConcurrentReload();
+    measureReadThroughput();
+    testRcuIndex();
+    measureRcuReadThroughput();
+    testShardedIndex();
+    testThreadPool();
+    testQueryExecutor();
+    testForkJoin();
+    measureThreadPool();
+    testAsyncIndex();
+    measureAsyncLatency();
+    measureDeleteLatency();
+
+    std::cout << "\nTous les tests sont terminés avec succès !\n";
+    return 0;
+}
@@ -0,0 +1,176 @@
+// test_follower.cpp
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <functional>
+#include "Index.h"
+#include "ConcurrentIndex.h"
+#include "FileFollower.h"
+
+// Fonction utilitaire pour vérifier les assertions
+#define TEST_ASSERT(condition, message) \
+    if (!(condition)) { \
+        std::cerr << "ÉCHEC: " << message << " (" << __FILE__ << ":" << __LINE__ << ")" << std::endl; \
+        exit(1); \
+    } else { \
+        std::cout << "SUCCÈS: " << message << std::endl; \
+    }
+
+const std::string FollowedPath = "/tmp/indexator-test-follow.txt";
+
+// Ajoute text à la fin du fichier
+void append(const std::string& path, const std::string& text) {
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    file << text;
+}
+
+// Remplace le contenu du fichier
+void rewrite(const std::string& path, const std::string& text) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+}
+
+// Attend que condition soit vraie, au plus timeoutMs millisecondes
+bool waitFor(std::function<bool()> condition, int timeoutMs = 2000) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return true;
+}
+
+// Lignes ajoutées en fin de fichier, y compris une ligne écrite en deux fois
+void testAppend() {
+    std::cout << "\n=== Test des ajouts suivis ===\n";
+
+    rewrite(FollowedPath, "1 ; 10\n1 ; 20\n2 ; 30\n");
+    ConcurrentIndex<int, int> index;
+    FileFollower<int, int> follower(index, FollowedPath);
+    TEST_ASSERT(follower.start() && index.getNbElements() == 3 && follower.getOffset() == 21,
+                "Chargement complet au démarrage");
+
+    append(FollowedPath, "3 ; 40\n3 ; 50\n4 ; 6");
+    TEST_ASSERT(waitFor([&]() { return index.getNbElements() == 5; }) && follower.getOffset() == 35
+                && !index.contains(4), "Seules les lignes complètes sont ingérées");
+
+    append(FollowedPath, "0\nmal formée\n");
+    TEST_ASSERT(waitFor([&]() { return index.contains(4); }) && index.getElements(4)[0].getValue() == 60
+                && follower.getErrors() == 1, "Ligne complétée ingérée, ligne invalide ignorée");
+    TEST_ASSERT(follower.getReloads() == 1 && follower.getIngestedLines() == 6, "Aucun rechargement pour des ajouts");
+
+    follower.stop();
+    append(FollowedPath, "5 ; 70\n");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    TEST_ASSERT(!index.contains(5), "Plus de suivi après stop()");
+    TEST_ASSERT(follower.catchUp() && index.contains(5), "catchUp() rattrape sans thread de suivi");
+    std::remove(FollowedPath.c_str());
+}
+
+// Troncature et rotation : rechargement complet
+void testTruncateAndRotate() {
+    std::cout << "\n=== Test troncature et rotation ===\n";
+
+    rewrite(FollowedPath, "1 ; 10\n1 ; 20\n2 ; 30\n");
+    ConcurrentIndex<int, int> index;
+    FileFollower<int, int> follower(index, FollowedPath);
+    follower.start();
+
+    rewrite(FollowedPath, "7 ; 70\n");
+    TEST_ASSERT(waitFor([&]() { return index.getNbElements() == 1 && index.contains(7); })
+                && follower.getReloads() == 2, "Fichier tronqué rechargé");
+
+    // Rotation : le fichier est renommé puis recréé
+    const std::string rotated = FollowedPath + ".1";
+    std::rename(FollowedPath.c_str(), rotated.c_str());
+    append(rotated, "8 ; 80\n");   // Écrit dans l'ancien fichier : ignoré
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    TEST_ASSERT(index.getNbElements() == 1 && !index.contains(8), "Index conservé pendant la rotation");
+    rewrite(FollowedPath, "9 ; 90\n9 ; 91\n");
+    TEST_ASSERT(waitFor([&]() { return index.getNbElements() == 2 && index.contains(9) && !index.contains(7); })
+                && follower.getReloads() == 3, "Nouveau fichier rechargé après rotation");
+
+    append(FollowedPath, "9 ; 92\n");
+    TEST_ASSERT(waitFor([&]() { return index.getElements(9).size() == 3; }), "Ajouts suivis dans le nouveau fichier");
+    FileFollower<int, int> missing(index, "/tmp/indexator-inexistant/index.txt");
+    TEST_ASSERT(!missing.start(), "Répertoire absent refusé");
+    std::remove(rotated.c_str());
+    std::remove(FollowedPath.c_str());
+}
+
+// Délai entre l'écriture d'une ligne et sa visibilité dans l'index
+void measureLag() {
+    std::cout << "\n=== Mesures du suivi ===\n";
+
+    rewrite(FollowedPath, "");
+    ConcurrentIndex<int, int> index;
+    FileFollower<int, int> follower(index, FollowedPath);
+    follower.start();
+
+    std::vector<double> lags;
+    std::ofstream file(FollowedPath, std::ios::binary | std::ios::app);
+    for (int i = 0; i < 500; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        file << i << " ; " << i << '\n';
+        file.flush();
+        bool seen = waitFor([&]() { return index.getNbElements() == i + 1; });
+        lags.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        if (!seen) {
+            break;
+        }
+    }
+    TEST_ASSERT(lags.size() == 500 && index.getNbElements() == 500, "Chaque ligne ajoutée est ingérée");
+    std::sort(lags.begin(), lags.end());
+    std::cout << "Délai d'ingestion d'une ligne : médiane " << lags[lags.size() / 2] << " µs, p99 "
+              << lags[lags.size() * 99 / 100] << " µs, max " << lags.back() << " µs" << std::endl;
+
+    // Gros ajout d'un bloc, comparé à un rechargement complet du fichier
+    std::string block;
+    for (int i = 0; i < 1000000; ++i) {
+        block += std::to_string(i % 5000) + " ; " + std::to_string(i) + "\n";
+    }
+    auto start = std::chrono::steady_clock::now();
+    file << block;
+    file.flush();
+    TEST_ASSERT(waitFor([&]() { return index.getNbElements() == 1000500; }, 60000), "Bloc d'un million de lignes ingéré");
+    double appendMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Lignes isolées ajoutées au gros fichier : seules elles sont lues
+    lags.clear();
+    for (int i = 1; i <= 50; ++i) {
+        start = std::chrono::steady_clock::now();
+        file << -i << " ; " << i << '\n';
+        file.flush();
+        waitFor([&]() { return index.contains(-i); });
+        lags.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(lags.begin(), lags.end());
+
+    start = std::chrono::steady_clock::now();
+    index.loadFromFile(FollowedPath);
+    double reloadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "1 000 000 lignes ajoutées : ingérées en " << appendMs << " ms, rechargement complet du fichier "
+              << reloadMs << " ms" << std::endl;
+    std::cout << "Ligne ajoutée au fichier d'un million de lignes : médiane " << lags[lags.size() / 2]
+              << " µs" << std::endl;
+    follower.stop();
+    std::remove(FollowedPath.c_str());
+}
+
+int main() {
+    std::cout << "=== Programme de test pour le suivi de fichier ===\n";
+
+    testAppend();
+    testTruncateAndRotate();
+    measureLag();
+
+    std::cout << "\nTous les tests sont terminés avec succès !\n";
+    return 0;
+}
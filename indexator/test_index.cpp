@@ -0,0 +1,1393 @@
+// test_index.cpp
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include "Element.h"
+#include "Node.h"
+#include "Index.h"
+#include "IndexManager.h"
+#include "ExternalBuilder.h"
+#include "SpillingIndex.h"
+
+// Fonction utilitaire pour vérifier les assertions
+#define TEST_ASSERT(condition, message) \
+    if (!(condition)) { \
+        std::cerr << "ÉCHEC: " << message << " (" << __FILE__ << ":" << __LINE__ << ")" << std::endl; \
+        exit(1); \
+    } else { \
+        std::cout << "SUCCÈS: " << message << std::endl; \
+    }
+
+// Remplit un index avec les paires fournies
+template <typename K, typename V>
+void fillIndex(Index<K, V>& index, const std::vector<std::pair<K, V>>& data) {
+    for (const auto& pair : data) {
+        index.addElement(new Element<K, V>(pair.first, pair.second));
+    }
+}
+
+// Test de la recherche groupée multiGet
+void testMultiGet() {
+    std::cout << "\n=== Test multiGet ===\n";
+
+    Index<int, std::string> index;
+    fillIndex<int, std::string>(index, {
+        {10, "Alice"}, {10, "Bruno"}, {12, "Claire"}, {14, "Emma"}, {14, "David"}, {20, "Zoé"}
+    });
+
+    std::vector<int> keys = {14, 3, 10, 14, 99, 20, 12, 10};
+    std::vector<std::vector<Element<int, std::string>*>> results;
+    index.multiGet(keys, results);
+
+    TEST_ASSERT(results.size() == keys.size(), "Un résultat par clé demandée");
+    bool sameAsGetElements = true;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (results[i] != index.getElements(keys[i])) {
+            sameAsGetElements = false;
+        }
+    }
+    TEST_ASSERT(sameAsGetElements, "multiGet retourne les mêmes éléments que getElements");
+    TEST_ASSERT(results[1].empty() && results[4].empty(), "Les clés absentes donnent un résultat vide");
+    TEST_ASSERT(results[0].size() == 2 && results[3].size() == 2, "Les clés dupliquées sont résolues");
+
+    // Réutilisation du tampon de sortie
+    std::vector<int> fewerKeys = {20};
+    index.multiGet(fewerKeys, results);
+    TEST_ASSERT(results.size() == 1 && results[0].size() == 1 && results[0][0]->getValue() == "Zoé",
+                "Le tampon de sortie est réutilisé");
+}
+
+// Convertit l'index en liste de paires dans l'ordre de parcours
+template <typename K, typename V>
+std::vector<std::pair<K, V>> dumpIndex(const Index<K, V>& index, const std::vector<K>& keys) {
+    std::vector<std::pair<K, V>> dump;
+    for (const K& key : keys) {
+        for (auto* element : index.getElements(key)) {
+            dump.emplace_back(element->getKey(), element->getValue());
+        }
+    }
+    return dump;
+}
+
+// Test de l'insertion groupée insertBatch
+void testInsertBatch() {
+    std::cout << "\n=== Test insertBatch ===\n";
+
+    std::vector<std::pair<int, int>> initial = {{5, 50}, {1, 10}, {9, 90}, {5, 40}};
+    std::vector<std::pair<int, int>> batch = {{7, 70}, {5, 45}, {1, 5}, {0, 1}, {7, 60}, {12, 3}, {5, 40}};
+
+    Index<int, int> expected;
+    fillIndex(expected, initial);
+    fillIndex(expected, batch);
+
+    Index<int, int> index;
+    fillIndex(index, initial);
+    index.insertBatch(batch);
+
+    std::vector<int> keys = {0, 1, 5, 7, 9, 12};
+    TEST_ASSERT(index.getNbElements() == expected.getNbElements(), "Même nombre d'éléments qu'avec addElement");
+    TEST_ASSERT(dumpIndex(index, keys) == dumpIndex(expected, keys), "Même contenu qu'avec addElement");
+
+    auto fives = index.getElements(5);
+    TEST_ASSERT(fives.size() == 4 && fives[0]->getValue() == 40 && fives[3]->getValue() == 50,
+                "Les éléments fusionnés restent triés par valeur");
+
+    index.insertBatch(std::vector<std::pair<int, int>>());
+    TEST_ASSERT(index.getNbElements() == expected.getNbElements(), "Un lot vide ne change rien");
+}
+
+// Test des suppressions groupées
+void testBulkDelete() {
+    std::cout << "\n=== Test deleteRange / deleteWhere ===\n";
+
+    Index<int, int> index;
+    for (int key = 0; key < 20; ++key) {
+        for (int value = 0; value < 10; ++value) {
+            index.addElement(new Element<int, int>(key, value));
+        }
+    }
+
+    TEST_ASSERT(index.deleteRange(5, 9) == 50, "deleteRange supprime les clés de l'intervalle inclus");
+    TEST_ASSERT(index.getNode(5) == nullptr && index.getNode(9) == nullptr, "Les nœuds de l'intervalle sont supprimés");
+    TEST_ASSERT(index.getNode(4) != nullptr && index.getNode(10) != nullptr, "Les bornes extérieures sont conservées");
+    TEST_ASSERT(index.deleteRange(9, 5) == 0, "Un intervalle inversé ne supprime rien");
+
+    int removed = index.deleteWhere(3, [](const Element<int, int>& e) { return e.getValue() % 2 == 0; });
+    TEST_ASSERT(removed == 5 && index.getElements(3).size() == 5, "deleteWhere(clé) filtre un seul nœud");
+
+    removed = index.deleteWhere([](const Element<int, int>& e) { return e.getKey() >= 15 || e.getValue() == 1; });
+    TEST_ASSERT(removed == 50 + 10, "deleteWhere(prédicat) parcourt tout l'index");
+    TEST_ASSERT(index.getNode(15) == nullptr && index.getNode(19) == nullptr, "Les nœuds vidés sont supprimés");
+    TEST_ASSERT(index.getNbElements() == 200 - 50 - 5 - 60, "Le nombre d'éléments restant est correct");
+
+    auto elements = index.getElements(3);
+    bool sorted = std::is_sorted(elements.begin(), elements.end(),
+                                 [](auto* a, auto* b) { return a->getValue() < b->getValue(); });
+    TEST_ASSERT(sorted, "Le compactage conserve l'ordre des éléments");
+}
+
+// Test de la suppression paresseuse : mêmes résultats que le mode immédiat
+void testLazyDeletion() {
+    std::cout << "\n=== Test suppression paresseuse ===\n";
+
+    Index<int, int> eager;
+    Index<int, int> lazy;
+    lazy.setLazyDeletion(true, 0.5);
+    for (int i = 0; i < 400; ++i) {
+        eager.addElement(new Element<int, int>(i % 20, i));
+        lazy.addElement(new Element<int, int>(i % 20, i));
+    }
+
+    bool sameResults = true;
+    for (int i = 0; i < 400; i += 3) {
+        Element<int, int> target(i % 20, i);
+        sameResults = sameResults && (eager.deleteElement(&target) == lazy.deleteElement(&target));
+        sameResults = sameResults && (eager.getNbElements() == lazy.getNbElements());
+    }
+    TEST_ASSERT(sameResults, "deleteElement et getNbElements restent exacts en mode paresseux");
+    TEST_ASSERT(lazy.getNbDeleted() > 0, "Des éléments restent marqués en attente de compactage");
+
+    TEST_ASSERT(lazy.deleteNode(4) && lazy.getNode(4) == nullptr, "deleteNode masque le nœud immédiatement");
+    TEST_ASSERT(lazy.getElements(4).empty(), "Un nœud supprimé ne retourne plus d'éléments");
+    eager.deleteNode(4);
+
+    Element<int, int> revived(4, 1000);
+    lazy.addElement(new Element<int, int>(4, 1000));
+    eager.addElement(new Element<int, int>(4, 1000));
+    TEST_ASSERT(lazy.getElements(4).size() == 1 && *lazy.getElements(4)[0] == revived,
+                "Un nœud marqué supprimé est réutilisé par addElement");
+
+    std::vector<int> keys;
+    for (int key = 0; key < 20; ++key) keys.push_back(key);
+    TEST_ASSERT(dumpIndex(lazy, keys) == dumpIndex(eager, keys), "Le contenu visible est identique");
+
+    lazy.compact();
+    TEST_ASSERT(lazy.getNbDeleted() == 0 && lazy.getNbElements() == eager.getNbElements(),
+                "compact libère tous les éléments marqués");
+}
+
+// Test des compteurs tenus à jour et des statistiques
+void testStats() {
+    std::cout << "\n=== Test getStats ===\n";
+
+    Index<int, int> index;
+    for (int key = 1; key <= 10; ++key) {
+        for (int value = 0; value < key; ++value) {
+            index.addElement(new Element<int, int>(key, value));
+        }
+    }
+    TEST_ASSERT(index.getNbElements() == 55 && index.getNbNodes() == 10, "Compteurs après ajouts");
+
+    index.deleteNode(10);
+    index.deleteRange(1, 2);
+    index.deleteWhere([](const Element<int, int>& e) { return e.getValue() == 0; });
+    Element<int, int> target(9, 8);
+    index.deleteElement(&target);
+    index.insertBatch(std::vector<std::pair<int, int>>{{42, 1}, {3, 7}});
+    // 55 - 10 - 3 - 7 (valeur 0 des clés 3 à 9) - 1 + 2
+    TEST_ASSERT(index.getNbElements() == 36 && index.getNbNodes() == 8, "Compteurs après suppressions et lot");
+
+    IndexStats stats = index.getStats();
+    TEST_ASSERT(stats.nbElements == 36 && stats.nbNodes == 8, "Les statistiques reprennent les compteurs");
+    TEST_ASSERT(stats.minPerNode == 1 && stats.maxPerNode == 7, "Minimum et maximum par nœud");
+    TEST_ASSERT(stats.p50PerNode >= stats.minPerNode && stats.p99PerNode <= stats.maxPerNode, "Percentiles bornés");
+    TEST_ASSERT(stats.elementBytes >= 36 * sizeof(Element<int, int>), "Estimation mémoire des éléments");
+}
+
+// Test des instantanés : figés pendant que l'index évolue
+void testSnapshot() {
+    std::cout << "\n=== Test snapshot ===\n";
+
+    Index<int, int> index;
+    for (int key = 1; key <= 5; ++key) {
+        for (int value = 0; value < 3; ++value) {
+            index.addElement(new Element<int, int>(key, value));
+        }
+    }
+
+    auto snapshot = index.snapshot();
+    std::ostringstream before;
+    before << *snapshot;
+    uint64_t version = index.getVersion();
+    TEST_ASSERT(snapshot->getVersion() == version, "L'instantané porte la version de l'index");
+
+    index.addElement(new Element<int, int>(1, 10));
+    index.addElement(new Element<int, int>(6, 0));
+    Element<int, int> target(2, 1);
+    index.deleteElement(&target);
+    index.deleteNode(3);
+    index.insertBatch(std::vector<std::pair<int, int>>{{4, 5}, {7, 7}});
+    index.deleteWhere([](const Element<int, int>& e) { return e.getValue() == 0; });
+
+    std::ostringstream after;
+    after << *snapshot;
+    TEST_ASSERT(before.str() == after.str(), "L'instantané n'est pas modifié par l'index");
+    TEST_ASSERT(snapshot->getNbElements() == 15 && snapshot->getNbNodes() == 5, "Compteurs de l'instantané inchangés");
+    TEST_ASSERT(index.getVersion() > version, "La version de l'index augmente");
+    // 15 + 2 - 1 - 3 + 2 - 5 (valeur 0 des clés 1, 2, 4, 5, 6)
+    TEST_ASSERT(index.getNbElements() == 10 && index.getNode(3) == nullptr, "L'index voit ses modifications");
+
+    // Un élément lu dans l'instantané survit à sa suppression de l'index
+    const Element<int, int>* kept = snapshot->getElements(5)[2];
+    index.deleteNode(5);
+    TEST_ASSERT(kept->getKey() == 5 && kept->getValue() == 2, "Les éléments de l'instantané restent valides");
+
+    // L'instantané survit à l'index
+    auto older = index.snapshot();
+    index.setLazyDeletion(true);
+    Element<int, int> lazy(1, 1);
+    index.deleteElement(&lazy);
+    TEST_ASSERT(older->getElements(1).size() == 3 && index.getElements(1).size() == 2,
+                "Suppression paresseuse sur un nœud partagé");
+    {
+        Index<int, int> temporary;
+        temporary.addElement(new Element<int, int>(1, 1));
+        older = temporary.snapshot();
+    }
+    TEST_ASSERT(older->getNbElements() == 1 && older->getElements(1).size() == 1, "L'instantané survit à son index");
+}
+
+// Test du clonage par copie sur écriture
+void testClone() {
+    std::cout << "\n=== Test clone ===\n";
+
+    Index<int, std::string> index;
+    for (int key = 0; key < 10; ++key) {
+        for (int value = 0; value < 4; ++value) {
+            index.addElement(new Element<int, std::string>(key, "valeur-" + std::to_string(value)));
+        }
+    }
+
+    std::unique_ptr<Index<int, std::string>> copy = index.clone();
+    IndexStats shared = index.getStats();
+    TEST_ASSERT(shared.sharedBytes == shared.nodeBytes + shared.elementBytes, "Tous les nœuds sont partagés après clone");
+
+    // Modifications indépendantes des deux côtés
+    copy->addElement(new Element<int, std::string>(0, "clone"));
+    copy->deleteNode(1);
+    Element<int, std::string> target(2, "valeur-0");
+    index.deleteElement(&target);
+    index.insertBatch(std::vector<std::pair<int, std::string>>{{20, "nouveau"}});
+
+    TEST_ASSERT(index.getElements(0).size() == 4 && copy->getElements(0).size() == 5, "Ajout dans le clone seul");
+    TEST_ASSERT(index.getNode(1) != nullptr && copy->getNode(1) == nullptr, "Suppression de nœud dans le clone seul");
+    TEST_ASSERT(index.getElements(2).size() == 3 && copy->getElements(2).size() == 4, "Suppression dans l'original seul");
+    TEST_ASSERT(index.getNbElements() == 40 && copy->getNbElements() == 37, "Compteurs indépendants");
+    TEST_ASSERT(copy->getNode(20) == nullptr, "Le lot de l'original n'apparaît pas dans le clone");
+
+    // Seuls les nœuds 0 et 2 ont été dupliqués ; le nœud 1 n'est plus partagé
+    IndexStats stats = index.getStats();
+    TEST_ASSERT(stats.sharedBytes > 0 && stats.privateBytes() > stats.directoryBytes, "Octets partagés et privés");
+    TEST_ASSERT(index.getNode(3) == copy->getNode(3), "Les nœuds non modifiés restent partagés");
+
+    copy.reset();
+    TEST_ASSERT(index.getStats().sharedBytes == 0 && index.getElements(5).size() == 4,
+                "Plus rien n'est partagé après destruction du clone");
+}
+
+// Test d'un lot assez grand pour être trié sur la réserve de threads
+void testLargeBatch() {
+    std::cout << "\n=== Test insertBatch (tri parallèle) ===\n";
+
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < 200000; ++i) {
+        data.emplace_back((i * 7919) % 20000, i % 37);
+    }
+    Index<int, int> parallel;
+    parallel.insertBatch(data);
+
+    Index<int, int> sequential;
+    for (size_t first = 0; first < data.size(); first += 1000) {
+        sequential.insertBatch(std::vector<std::pair<int, int>>(data.begin() + first, data.begin() + first + 1000));
+    }
+
+    std::ostringstream expected, actual;
+    expected << sequential;
+    actual << parallel;
+    TEST_ASSERT(parallel.getNbElements() == 200000 && parallel.getNbNodes() == 20000, "Compteurs du grand lot");
+    TEST_ASSERT(expected.str() == actual.str(), "Même index qu'avec des petits lots");
+}
+
+// Test de l'avancement et de l'annulation d'un chargement
+void testLoadProgress() {
+    std::cout << "\n=== Test LoadProgress ===\n";
+
+    Index<char, std::string> index;
+    LoadProgress progress;
+    TEST_ASSERT(index.loadFromFile("exemple_index/format-incorrect.txt", &progress), "Chargement avec avancement");
+    TEST_ASSERT(progress.bytesRead == progress.totalBytes && progress.percent() == 100.0, "Tout le fichier est lu");
+    TEST_ASSERT(progress.errors == 5, "Les lignes mal formatées sont comptées");
+    int count = index.getNbElements();
+
+    // Un chargement annulé ou impossible laisse l'index intact
+    LoadProgress cancelled;
+    cancelled.cancelled = true;
+    TEST_ASSERT(!index.loadFromFile("exemple_index/complexe-notes.txt", &cancelled), "Chargement annulé");
+    TEST_ASSERT(!index.loadFromFile("exemple_index/absent.txt"), "Fichier absent");
+    TEST_ASSERT(index.getNbElements() == count && index.getNode('a') != nullptr, "L'index est conservé après échec");
+}
+
+// Test du chargement en arrière-plan du gestionnaire
+void testBackgroundLoad() {
+    std::cout << "\n=== Test chargement en arrière-plan ===\n";
+
+    IndexManager manager;
+    TEST_ASSERT(manager.loadIntStringIndex("exemple_index/complexe-notes.txt") && manager.isLoading(),
+                "Chargement lancé");
+    TEST_ASSERT(manager.waitForLoad() && manager.isIndexLoaded() && !manager.isLoading(), "Chargement adopté");
+
+    // Un échec de chargement conserve l'index courant
+    TEST_ASSERT(!manager.loadIntIntIndex("exemple_index/absent.txt") && manager.isIndexLoaded(),
+                "Fichier absent : l'index courant est conservé");
+    TEST_ASSERT(manager.loadCharStringIndex("exemple_index/simples-notes.txt") && manager.cancelLoad()
+                && !manager.isLoading() && manager.isIndexLoaded(), "Annulation : l'index courant est conservé");
+
+    // Remplacement par un autre type d'index
+    TEST_ASSERT(manager.loadIntIntIndex("exemple_index/complexe-nombres.txt"), "Second chargement lancé");
+    while (!manager.adoptPendingLoad()) {
+        std::this_thread::yield();
+    }
+    TEST_ASSERT(manager.isIndexLoaded() && !manager.isLoading(), "Nouvel index adopté");
+
+    // Retraits successifs de gros index : aucun n'attend la libération du précédent
+    const std::string path = "/tmp/indexator-test-release.txt";
+    {
+        std::ofstream file(path);
+        for (int i = 0; i < 1000000; ++i) {
+            file << i % 50000 << " ; " << i << "\n";
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    {
+        Index<int, int> freed;
+        freed.loadFromFile(path);
+        start = std::chrono::steady_clock::now();
+    }
+    double freeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    const std::vector<std::string> names = {"r1", "r2", "r3", "r4"};
+    for (const auto& name : names) {
+        manager.loadIntIntIndex(path, name);
+        manager.waitForLoad();
+    }
+    manager.activateIndex("exemple_index/complexe-nombres.txt");
+    start = std::chrono::steady_clock::now();
+    bool removed = true;
+    for (const auto& name : names) {
+        removed = manager.removeIndex(name) && removed;
+    }
+    double removeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Libération d'un index : " << freeMs << " ms ; quatre retraits successifs : " << removeMs << " ms" << std::endl;
+    TEST_ASSERT(removed && removeMs < freeMs, "Retraits sans attendre les libérations précédentes");
+    std::remove(path.c_str());
+}
+
+// Test des instantanés binaires : relecture identique, type vérifié
+void testBinarySnapshot() {
+    std::cout << "\n=== Test saveSnapshot / loadSnapshot ===\n";
+
+    const std::string path = "/tmp/indexator-test-snapshot.idx";
+    Index<int, std::string> index;
+    TEST_ASSERT(index.loadFromFile("exemple_index/complexe-notes.txt"), "Chargement du fichier texte");
+    index.addElement(new Element<int, std::string>(99, "avec ; séparateur et\nretour à la ligne"));
+    index.addElement(new Element<int, std::string>(99, ""));
+    TEST_ASSERT(index.saveSnapshot(path), "Écriture de l'instantané");
+
+    Index<int, std::string> reloaded;
+    TEST_ASSERT(reloaded.loadSnapshot(path), "Relecture de l'instantané");
+    std::ostringstream expected, actual;
+    expected << index;
+    actual << reloaded;
+    TEST_ASSERT(expected.str() == actual.str() && reloaded.getNbElements() == index.getNbElements()
+                && reloaded.getNbNodes() == index.getNbNodes(), "L'index relu est identique");
+
+    Index<int, int> otherType;
+    otherType.addElement(new Element<int, int>(1, 1));
+    TEST_ASSERT(!otherType.loadSnapshot(path) && otherType.getNbElements() == 1,
+                "Un instantané d'un autre type est refusé");
+    TEST_ASSERT(!otherType.loadSnapshot("exemple_index/simples-nombres.txt"), "Un fichier texte est refusé");
+
+    // Instantanés corrompus : refusés sans allocation démesurée, l'index reste inchangé.
+    // En-tête : signature (4), version (4), types (2), nombre de nœuds (8) ; puis la première
+    // clé (4), son nombre d'éléments (8) et la longueur de sa première valeur (8).
+    std::string original;
+    {
+        std::ifstream file(path, std::ios::binary);
+        original.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    auto corrupted = [&](size_t offset, uint64_t count) {
+        std::string bytes = original;
+        std::copy(reinterpret_cast<const char*>(&count), reinterpret_cast<const char*>(&count) + sizeof(count),
+                  bytes.begin() + offset);
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+        return !reloaded.loadSnapshot(path) && reloaded.getNbElements() == index.getNbElements();
+    };
+    TEST_ASSERT(corrupted(10, uint64_t(1) << 60), "Nombre de nœuds démesuré refusé");
+    TEST_ASSERT(corrupted(30, uint64_t(1) << 50), "Longueur de chaîne démesurée refusée");
+    TEST_ASSERT(corrupted(22, uint64_t(1) << 62), "Nombre d'éléments démesuré refusé");
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << original.substr(0, original.size() / 2);
+    TEST_ASSERT(!reloaded.loadSnapshot(path) && reloaded.getNbElements() == index.getNbElements(),
+                "Instantané tronqué refusé");
+    std::remove(path.c_str());
+}
+
+// Contenu d'un fichier
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+// Charge filename, l'enregistre au format texte puis le relit : même index, et un second
+// enregistrement redonne le même fichier
+template <typename K, typename V>
+bool roundTrip(const std::string& filename) {
+    const std::string path = "/tmp/indexator-test-export.txt";
+    Index<K, V> original, reloaded;
+    if (!original.loadFromFile(filename) || !original.saveToFile(path) || !reloaded.loadFromFile(path)) {
+        return false;
+    }
+    std::ostringstream expected, actual;
+    expected << original;
+    actual << reloaded;
+    std::string saved = readFile(path);
+    bool same = expected.str() == actual.str() && reloaded.getNbElements() == original.getNbElements()
+                && reloaded.saveToFile(path) && readFile(path) == saved;
+    std::remove(path.c_str());
+    return same;
+}
+
+// Test de l'export texte saveToFile
+void testSaveToFile() {
+    std::cout << "\n=== Test saveToFile ===\n";
+
+    TEST_ASSERT((roundTrip<char, std::string>("exemple_index/simples-prenoms.txt")), "simples-prenoms relu à l'identique");
+    TEST_ASSERT((roundTrip<char, std::string>("exemple_index/special-case.txt")),
+                "special-case relu à l'identique (points-virgules, valeur vide)");
+    TEST_ASSERT((roundTrip<char, std::string>("exemple_index/format-incorrect.txt")), "format-incorrect relu à l'identique");
+    TEST_ASSERT((roundTrip<int, std::string>("exemple_index/simples-notes.txt")), "simples-notes relu à l'identique");
+    TEST_ASSERT((roundTrip<int, std::string>("exemple_index/complexe-notes.txt")), "complexe-notes relu à l'identique");
+    TEST_ASSERT((roundTrip<int, int>("exemple_index/simples-nombres.txt")), "simples-nombres relu à l'identique");
+    TEST_ASSERT((roundTrip<int, int>("exemple_index/complexe-nombres.txt")), "complexe-nombres relu à l'identique");
+    TEST_ASSERT((roundTrip<int, int>("exemple_index/special-case-int.txt")), "special-case-int relu à l'identique (bornes)");
+
+    // Format et éléments supprimés
+    const std::string path = "/tmp/indexator-test-export.txt";
+    Index<int, std::string> index;
+    index.setLazyDeletion(true);
+    fillIndex<int, std::string>(index, {{2, "b;c"}, {-1, "a"}, {2, "a"}, {3, "x"}});
+    Element<int, std::string> target(2, "a");
+    index.deleteElement(&target);
+    TEST_ASSERT(index.saveToFile(path) && readFile(path) == "-1 ; a\n2 ; b;c\n3 ; x\n", "Une ligne \"clé ; valeur\" par élément vivant");
+
+    // Échec signalé ; succès sans fichier temporaire laissé
+    TEST_ASSERT(!index.saveToFile("/tmp/indexator-inexistant/export.txt"), "Répertoire absent signalé");
+    TEST_ASSERT(!std::ifstream(path + ".tmp").is_open(), "Aucun fichier temporaire laissé");
+    TEST_ASSERT(index.saveToFile(path) && readFile(path) == "-1 ; a\n2 ; b;c\n3 ; x\n", "Fichier existant remplacé");
+
+    // Gros index sur plusieurs tranches et plusieurs threads : même fichier qu'en séquentiel
+    Index<int, int> large;
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < 2000000; ++i) {
+        data.emplace_back(i % 100000 - 50000, i);
+    }
+    large.insertBatch(data);
+    ThreadPool pool(4), single(1);
+    TEST_ASSERT(large.saveToFile(path, single), "Export séquentiel");
+    std::string sequential = readFile(path);
+    auto start = std::chrono::steady_clock::now();
+    TEST_ASSERT(large.saveToFile(path, pool), "Export parallèle");
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::string parallel = readFile(path);
+    TEST_ASSERT(parallel == sequential, "Même fichier quel que soit le nombre de threads");
+
+    Index<int, int> reloaded;
+    TEST_ASSERT(reloaded.loadFromFile(path) && reloaded.getNbElements() == 2000000
+                && reloaded.countRange(-50000, -50000) == 20, "Gros export relu");
+
+    // Comparaison avec une écriture ligne à ligne par un flux
+    auto streamStart = std::chrono::steady_clock::now();
+    {
+        std::ofstream stream(path);
+        for (auto* element : large.getRange(-50000, 49999)) {
+            stream << element->getKey() << " ; " << element->getValue() << "\n";
+        }
+    }
+    double streamSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - streamStart).count();
+    std::cout << "saveToFile : " << parallel.size() / 1e6 / seconds << " Mo/s, flux ligne à ligne : "
+              << parallel.size() / 1e6 / streamSeconds << " Mo/s (" << parallel.size() / 1e6 << " Mo)" << std::endl;
+    std::remove(path.c_str());
+}
+
+// Test de la relecture différentielle reloadFromFile
+void testReloadFromFile() {
+    std::cout << "\n=== Test reloadFromFile ===\n";
+
+    const std::string path = "/tmp/indexator-test-reload.txt";
+    std::ofstream(path) << "1 ; a\n1 ; b\n2 ; c\n3 ; d\n3 ; d\n";
+    Index<int, std::string> index;
+    TEST_ASSERT(index.loadFromFile(path) && index.getNbElements() == 5, "Chargement initial");
+    std::unique_ptr<Index<int, std::string>> before = index.clone();
+
+    // 1 inchangé ; 2 disparaît ; 3 perd un double et gagne une valeur ; 4 apparaît
+    std::ofstream(path) << "3 ; e\n1 ; b\n1 ; a\n3 ; d\n4 ; f\nligne invalide\n";
+    ReloadSummary<int> summary;
+    TEST_ASSERT(index.reloadFromFile(path, &summary), "Relecture différentielle");
+    TEST_ASSERT(summary.added == 2 && summary.removed == 2 && summary.unchanged == 3
+                && summary.nodesAdded == 1 && summary.nodesRemoved == 1, "Nombre de changements");
+    TEST_ASSERT((summary.changedKeys == std::vector<int>{2, 3, 4}), "Clés modifiées, triées");
+
+    Index<int, std::string> expected;
+    expected.loadFromFile(path);
+    std::ostringstream expectedText, actualText;
+    expectedText << expected;
+    actualText << index;
+    TEST_ASSERT(actualText.str() == expectedText.str() && index.getNbElements() == 5 && index.getNbNodes() == 3,
+                "Même contenu qu'un chargement complet");
+    TEST_ASSERT(index.isNodeShared(1) && !index.isNodeShared(3) && before->getElements(2).size() == 1,
+                "Nœud inchangé conservé sans copie, clone intact");
+
+    uint64_t version = index.getVersion();
+    TEST_ASSERT(index.reloadFromFile(path, &summary) && summary.empty() && summary.changedKeys.empty()
+                && index.getVersion() == version, "Fichier identique : rien n'est modifié");
+    TEST_ASSERT(!index.reloadFromFile("/tmp/indexator-inexistant.txt") && index.getNbElements() == 5,
+                "Fichier absent : index inchangé");
+
+    // Suppression paresseuse : nœuds marqués supprimés retirés, éléments marqués ignorés
+    Index<int, std::string> lazy;
+    lazy.setLazyDeletion(true, 0.9);
+    lazy.loadFromFile(path);
+    Element<int, std::string> e3(3, "e"), f4(4, "f");
+    lazy.deleteElement(&e3);
+    lazy.deleteElement(&f4);
+    TEST_ASSERT(lazy.reloadFromFile(path, &summary) && summary.added == 2 && summary.removed == 0
+                && lazy.getNbElements() == 5 && lazy.getNbNodes() == 3, "Relecture d'un index à suppression paresseuse");
+
+    // Gros index, quelques lignes modifiées : comparé à un chargement complet
+    Index<int, int> large;
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < 1000000; ++i) {
+        data.emplace_back(i % 10000, i);
+    }
+    large.insertBatch(data);
+    TEST_ASSERT(large.saveToFile(path), "Export du gros index");
+    {
+        std::ofstream file(path, std::ios::app);
+        for (int i = 0; i < 100; ++i) {
+            file << 20000 + i << " ; " << i << "\n";
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    Index<int, int> full;
+    full.loadFromFile(path);
+    double fullMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    TEST_ASSERT(large.reloadFromFile(path, &summary) && summary.added == 100 && summary.removed == 0
+                && large.getNbElements() == full.getNbElements(), "100 lignes ajoutées sur un million");
+    double reloadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Chargement complet : " << fullMs << " ms, relecture différentielle : " << reloadMs << " ms" << std::endl;
+    std::remove(path.c_str());
+}
+
+// Capture l'affichage de l'index actif du gestionnaire
+std::string displayed(const IndexManager& manager) {
+    std::ostringstream out;
+    std::streambuf* previous = std::cout.rdbuf(out.rdbuf());
+    manager.displayCurrentIndex();
+    std::cout.rdbuf(previous);
+    return out.str();
+}
+
+// Test du registre d'index nommés et de l'éviction LRU
+void testIndexRegistry() {
+    std::cout << "\n=== Test registre d'index ===\n";
+
+    IndexManager manager;
+    manager.setPageSize(0);   // Affichages comparés en entier
+    TEST_ASSERT(manager.loadIntStringIndex("exemple_index/complexe-notes.txt", "notes") && manager.waitForLoad(),
+                "Premier index chargé");
+    std::string notes = displayed(manager);
+    TEST_ASSERT(manager.loadIntIntIndex("exemple_index/complexe-nombres.txt", "nombres") && manager.waitForLoad(),
+                "Second index chargé");
+    TEST_ASSERT(manager.loadCharStringIndex("exemple_index/simples-prenoms.txt") && manager.waitForLoad(),
+                "Troisième index chargé, nommé d'après son fichier");
+    TEST_ASSERT(manager.getIndexNames().size() == 3 && manager.getCurrentName() == "exemple_index/simples-prenoms.txt",
+                "Trois index enregistrés, le dernier est actif");
+
+    TEST_ASSERT(manager.activateIndex("notes") && displayed(manager) == notes, "Retour instantané au premier index");
+    TEST_ASSERT(!manager.activateIndex("absent"), "Nom inconnu refusé");
+
+    // Budget minimal : seul l'index actif reste en mémoire
+    manager.setMemoryBudget(1);
+    TEST_ASSERT(manager.isResident("notes") && !manager.isResident("nombres")
+                && !manager.isResident("exemple_index/simples-prenoms.txt"), "Les autres index sont évincés");
+    TEST_ASSERT(manager.activateIndex("nombres") && manager.isResident("nombres") && !manager.isResident("notes"),
+                "Réactivation depuis l'instantané, l'ancien actif est évincé");
+    TEST_ASSERT(manager.activateIndex("notes") && displayed(manager) == notes, "Index évincé relu à l'identique");
+
+    manager.setMemoryBudget(0);
+    TEST_ASSERT(manager.activateIndex("nombres") && manager.isResident("notes"), "Sans budget, rien n'est évincé");
+    TEST_ASSERT(!manager.removeIndex("nombres") && manager.removeIndex("notes")
+                && manager.getIndexNames().size() == 2, "Retrait d'un index inactif");
+}
+
+// Mode batch : sortie lisible par machine, erreurs signalées sans interrompre le script
+void testBatchMode() {
+    std::cout << "\n=== Test du mode batch ===\n";
+
+    IndexManager manager;
+    std::istringstream script(
+        "# commentaire\n"
+        "load ii exemple_index/simples-nombres.txt nombres\n"
+        "get 1\n"
+        "count 1 2\n"
+        "add 9 90\n"
+        "del 9 91\n"
+        "delnode 9\n"
+        "\n"
+        "load cs exemple_index/simples-prenoms.txt\n"
+        "add z Jean Pierre\n"
+        "get z\n"
+        "get zz\n"
+        "use nombres\n"
+        "count\n"
+        "inconnue\n");
+    std::ostringstream output;
+    int errors = manager.runBatch(script, output);
+
+    const std::string expected =
+        "ok\tload\t10\n"
+        "ok\tget\t3\n1\t10\n1\t20\n1\t30\n"
+        "ok\tcount\t5\n"
+        "ok\tadd\t1\n"
+        "notfound\tdel\t0\n"
+        "ok\tdelnode\t1\n"
+        "ok\tload\t10\n"
+        "ok\tadd\t1\n"
+        "ok\tget\t1\nz\tJean Pierre\n"
+        "error\tget\tligne 12: usage: get <clé>\n"
+        "ok\tuse\t10\n"
+        "ok\tcount\t10\n"
+        "error\tinconnue\tligne 15: commande inconnue\n";
+    TEST_ASSERT(output.str() == expected, "Résultats du script");
+    TEST_ASSERT(errors == 2, "Commandes en erreur comptées");
+    TEST_ASSERT(manager.getCurrentName() == "nombres", "use active l'index nommé");
+
+    std::istringstream timed("count\n");
+    std::ostringstream timedOutput;
+    BatchOptions timing;
+    timing.timing = true;
+    manager.runBatch(timed, timedOutput, timing);
+    TEST_ASSERT(timedOutput.str().rfind("ok\tcount\t10\t", 0) == 0, "Durée en quatrième champ avec timing");
+
+    // query : même sortie que les commandes du fichier, précédée du nombre de requêtes
+    const std::string queries = "/tmp/indexator-test-queries.txt";
+    const std::string queryLines = "get 1\n# commentaire\n\ncount 1 2\nrange 2 3\nget 42\ncount 3\n";
+    {
+        std::ofstream file(queries);
+        file << queryLines;
+    }
+    std::istringstream queryScript("query " + queries + "\n"), oneByOne(queryLines);
+    std::ostringstream queryOutput, oneByOneOutput;
+    TEST_ASSERT(manager.runBatch(queryScript, queryOutput) == 0, "query sans erreur");
+    manager.runBatch(oneByOne, oneByOneOutput);
+    TEST_ASSERT(queryOutput.str() == "ok\tquery\t5\n" + oneByOneOutput.str(), "query donne la sortie des commandes");
+    TEST_ASSERT(oneByOneOutput.str().rfind("ok\tget\t3\n1\t10\n", 0) == 0, "Éléments du premier get");
+
+    BatchOptions page;
+    page.offset = 1;
+    page.limit = 1;
+    std::istringstream pagedQuery("query " + queries + "\n"), pagedOneByOne(queryLines);
+    std::ostringstream pagedQueryOutput, pagedOneByOneOutput;
+    manager.runBatch(pagedQuery, pagedQueryOutput, page);
+    manager.runBatch(pagedOneByOne, pagedOneByOneOutput, page);
+    TEST_ASSERT(pagedQueryOutput.str() == "ok\tquery\t5\n" + pagedOneByOneOutput.str(), "query respecte la page");
+
+    {
+        std::ofstream file(queries);
+        file << "get 1\nget\n";
+    }
+    std::istringstream badQuery("query " + queries + "\nquery /tmp/indexator-absent.txt\nquery\n");
+    std::ostringstream badQueryOutput;
+    TEST_ASSERT(manager.runBatch(badQuery, badQueryOutput) == 3, "Requête invalide, fichier absent, usage");
+    TEST_ASSERT(badQueryOutput.str() == "error\tquery\tligne 1: " + queries + " ligne 2: requête invalide\n"
+                "error\tquery\tligne 2: impossible de lire /tmp/indexator-absent.txt\n"
+                "error\tquery\tligne 3: usage: query <fichier>\n", "Erreurs de query signalées sans exécution");
+    std::remove(queries.c_str());
+
+    // Débit sur un long script
+    std::string commands = "load ii exemple_index/simples-nombres.txt\n";
+    for (int i = 0; i < 100000; ++i) {
+        commands += (i % 2 == 0 ? "add " : "get ") + std::to_string(i % 1000) + (i % 2 == 0 ? " 1\n" : "\n");
+    }
+    std::istringstream longScript(commands);
+    std::ostringstream longOutput;
+    auto start = std::chrono::steady_clock::now();
+    errors = manager.runBatch(longScript, longOutput);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    TEST_ASSERT(errors == 0, "Long script sans erreur");
+    std::cout << "100000 commandes en " << ms << " ms" << std::endl;
+}
+
+// Sorties en flux : pages, curseurs et formatage parallèle
+void testPagedOutput() {
+    std::cout << "\n=== Test des sorties paginées ===\n";
+
+    Index<int, int> index;
+    index.setLazyDeletion(true);
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < 100000; ++i) {
+        data.emplace_back(i % 997, i);
+    }
+    index.insertBatch(data);
+    for (int i = 0; i < 100000; i += 3) {
+        Element<int, int> target(i % 997, i);
+        index.deleteElement(&target);   // Emplacements marqués supprimés à sauter
+    }
+
+    std::vector<Element<int, int>*> all = index.getRange(0, 996);
+    std::vector<Element<int, int>*> paged, page;
+    PageCursor cursor;
+    int pages = 0;
+    while (!cursor.done) {
+        page.clear();
+        index.collectPage(cursor, 1000, page);
+        TEST_ASSERT(page.size() <= 1000, "Page bornée");
+        paged.insert(paged.end(), page.begin(), page.end());
+        ++pages;
+    }
+    TEST_ASSERT(paged == all && pages >= static_cast<int>(all.size() / 1000), "Les pages successives couvrent l'index dans l'ordre");
+
+    // Page [offset, offset + limit)
+    std::ostringstream pageOutput;
+    {
+        BufferedWriter out(pageOutput);
+        ResultWriter<int, int> writer(out, ResultFormat::TSV, 2, 3);
+        TEST_ASSERT(!writer.write(all.begin(), all.end()) && writer.getWritten() == 3 && writer.getSkipped() == 2,
+                    "La page s'arrête après limit éléments");
+    }
+    std::string expected;
+    for (size_t i = 2; i < 5; ++i) {
+        expected += std::to_string(all[i]->getKey()) + "\t" + std::to_string(all[i]->getValue()) + "\n";
+    }
+    TEST_ASSERT(pageOutput.str() == expected, "Contenu de la page");
+
+    // Formatage parallèle : même sortie que le formatage séquentiel
+    std::ostringstream sequential, parallel;
+    ThreadPool pool(4);
+    {
+        BufferedWriter out(sequential);
+        ResultWriter<int, int> writer(out, ResultFormat::TEXT, 10, 50000);
+        writer.write(all.begin(), all.end());
+    }
+    {
+        BufferedWriter out(parallel);
+        ResultWriter<int, int> writer(out, ResultFormat::TEXT, 10, 50000);
+        writer.writeParallel(all, pool, 1000);
+        TEST_ASSERT(writer.getWritten() == 50000, "Nombre d'éléments écrits en parallèle");
+    }
+    TEST_ASSERT(parallel.str() == sequential.str(), "Le formatage parallèle conserve l'ordre");
+
+    std::ostringstream element;
+    element << *all[0] << "\n";
+    std::string line;
+    formatElement(*all[0], ResultFormat::TEXT, line);
+    TEST_ASSERT(line == element.str(), "Même présentation qu'operator<<");
+
+    // Affichage interactif par pages : on affiche la suite une fois puis on arrête
+    IndexManager manager;
+    manager.loadIntIntIndex("exemple_index/simples-nombres.txt");
+    manager.waitForLoad();
+    manager.setPageSize(3);
+    std::istringstream answers("\nq\n");
+    std::streambuf* previousInput = std::cin.rdbuf(answers.rdbuf());
+    std::string shown = displayed(manager);
+    std::cin.rdbuf(previousInput);
+    size_t lines = 0;
+    for (size_t pos = shown.find("Element["); pos != std::string::npos; pos = shown.find("Element[", pos + 1)) {
+        ++lines;
+    }
+    TEST_ASSERT(lines == 6 && shown.find("4 élément(s) restant(s)") != std::string::npos,
+                "Deux pages affichées, reprise au curseur");
+
+    manager.setPageSize(0);
+    std::string full = displayed(manager);
+    TEST_ASSERT(full.find("restant") == std::string::npos && full.find("Element[key=5, value=100]") != std::string::npos,
+                "Affichage complet sans pagination");
+
+    // Pagination du mode batch
+    std::istringstream script("load ii exemple_index/simples-nombres.txt\nget 1\n");
+    std::ostringstream output;
+    BatchOptions options;
+    options.offset = 1;
+    options.limit = 1;
+    manager.runBatch(script, output, options);
+    TEST_ASSERT(output.str() == "ok\tload\t10\nok\tget\t1\n1\t20\n", "--offset et --limit en mode batch");
+
+    // Temps d'un affichage complet
+    std::vector<Element<int, int>*> many;
+    PageCursor dumpCursor;
+    Index<int, int> large;
+    data.clear();
+    for (int i = 0; i < 1000000; ++i) {
+        data.emplace_back(i % 1000, i);
+    }
+    large.insertBatch(data);
+    large.collectPage(dumpCursor, ResultWriter<int, int>::NoLimit, many);
+    for (int variant = 0; variant < 3; ++variant) {
+        std::ostringstream sink;
+        auto start = std::chrono::steady_clock::now();
+        if (variant == 0) {
+            sink << large;
+        } else {
+            BufferedWriter out(sink);
+            ResultWriter<int, int> writer(out);
+            if (variant == 1) {
+                writer.write(many.begin(), many.end());
+            } else {
+                writer.writeParallel(many);
+            }
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        const char* names[] = {"operator<<", "ResultWriter", "ResultWriter parallèle"};
+        std::cout << names[variant] << " : " << many.size() << " éléments en " << ms << " ms" << std::endl;
+    }
+}
+
+// Test du chargement d'un répertoire : index séparés ou fusionnés
+void testLoadDirectory() {
+    std::cout << "\n=== Test loadDirectory ===\n";
+
+    std::vector<std::string> files;
+    for (const auto& item : std::filesystem::directory_iterator("exemple_index")) {
+        files.push_back(item.path().string());
+    }
+    std::sort(files.begin(), files.end());
+
+    // Référence : chaque fichier chargé seul, et tous insérés dans un même index
+    Index<char, std::string> all;
+    std::vector<size_t> errors;
+    for (const auto& file : files) {
+        std::vector<Element<char, std::string>*> batch;
+        LoadProgress progress;
+        Index<char, std::string>::readElements(file, batch, &progress);
+        errors.push_back(progress.errors);
+        all.insertElements(batch);
+    }
+
+    IndexManager manager;
+    manager.setPageSize(0);
+    std::vector<FileLoadReport> reports;
+    TEST_ASSERT(manager.loadDirectory("exemple_index", "cs", 3, false, &reports) && reports.size() == files.size(),
+                "Un bilan par fichier");
+    bool separate = true;
+    for (size_t i = 0; i < files.size(); ++i) {
+        Index<char, std::string> alone;
+        alone.loadFromFile(files[i]);
+        std::ostringstream expected;
+        expected << "Index de type Char/String :\n";
+        for (auto* element : alone.getRange(std::numeric_limits<char>::min(), std::numeric_limits<char>::max())) {
+            expected << *element << "\n";
+        }
+        separate = separate && reports[i].loaded && reports[i].filename == files[i] && reports[i].errors == errors[i]
+                   && manager.activateIndex(files[i]) && displayed(manager) == expected.str();
+    }
+    TEST_ASSERT(separate, "Chaque fichier dans son propre index, erreurs comptées par fichier");
+    TEST_ASSERT(*std::max_element(errors.begin(), errors.end()) > 0, "Fichier mal formé signalé dans son bilan");
+
+    TEST_ASSERT(manager.loadDirectory("exemple_index", "cs", 0, true, &reports) && manager.getCurrentName() == "exemple_index",
+                "Chargement fusionné sous le nom du répertoire");
+    std::ostringstream expected;
+    expected << "Index de type Char/String :\n";
+    for (auto* element : all.getRange(std::numeric_limits<char>::min(), std::numeric_limits<char>::max())) {
+        expected << *element << "\n";
+    }
+    TEST_ASSERT(displayed(manager) == expected.str(), "Index fusionné identique à l'insertion de tous les fichiers");
+    TEST_ASSERT(!manager.loadDirectory("/tmp/indexator-inexistant", "cs") && !manager.loadDirectory("exemple_index", "xx"),
+                "Répertoire absent ou type inconnu refusés");
+
+    // Fusion k-voies sur plusieurs intervalles de clés
+    std::vector<std::vector<Element<int, int>*>> runs(5);
+    Index<int, int> reference;
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < 200000; ++i) {
+        runs[i % 5].push_back(new Element<int, int>((i * 7919) % 30011, i % 13));
+        data.emplace_back((i * 7919) % 30011, i % 13);
+    }
+    for (auto& run : runs) {
+        std::sort(run.begin(), run.end(), [](const Element<int, int>* a, const Element<int, int>* b) { return *a < *b; });
+    }
+    reference.insertBatch(data);
+    Index<int, int> merged;
+    ThreadPool pool(4);
+    merged.mergeSortedRuns(runs, pool);
+    TEST_ASSERT(runs.empty() && merged.getNbElements() == 200000 && merged.getNbNodes() == reference.getNbNodes()
+                && merged.getRange(0, 30010).size() == 200000, "Fusion de 5 suites sur 4 threads");
+    bool same = true;
+    for (int key = 0; key < 30011 && same; key += 97) {
+        same = dumpIndex(merged, std::vector<int>{key}) == dumpIndex(reference, std::vector<int>{key});
+    }
+    TEST_ASSERT(same, "Même contenu qu'une insertion groupée");
+
+    // Débit : répertoire de 8 fichiers, fusionnés ou non, selon le nombre de threads
+    const std::string directory = "/tmp/indexator-test-directory";
+    std::filesystem::create_directories(directory);
+    for (int f = 0; f < 8; ++f) {
+        std::ofstream file(directory + "/part-" + std::to_string(f) + ".txt");
+        for (int i = 0; i < 125000; ++i) {
+            file << (i * 31 + f) % 50000 << " ; " << i << "\n";
+        }
+    }
+    for (bool merge : {false, true}) {
+        for (size_t threads : {size_t(1), size_t(4)}) {
+            IndexManager bench;
+            std::ostringstream quiet;
+            std::streambuf* previous = std::cout.rdbuf(quiet.rdbuf());
+            auto start = std::chrono::steady_clock::now();
+            bool ok = bench.loadDirectory(directory, "ii", threads, merge);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::cout.rdbuf(previous);
+            TEST_ASSERT(ok, "Chargement du répertoire de test");
+            std::cout << (merge ? "Fusionné" : "Séparé") << ", " << threads << " thread(s) : 1 000 000 lignes en "
+                      << ms << " ms" << std::endl;
+        }
+    }
+    std::filesystem::remove_all(directory);
+}
+
+// Construit filename par tri externe avec memoryBytes de mémoire : même instantané que
+// loadFromFile suivi de saveSnapshot
+template <typename K, typename V>
+bool sameSnapshot(const std::string& filename, size_t memoryBytes) {
+    const std::string expectedPath = "/tmp/indexator-test-expected.idx";
+    const std::string builtPath = "/tmp/indexator-test-built.idx";
+    Index<K, V> index;
+    ExternalBuilder<K, V> builder(memoryBytes);
+    bool same = index.loadFromFile(filename) && index.saveSnapshot(expectedPath)
+                && builder.build(filename, builtPath) && readFile(builtPath) == readFile(expectedPath)
+                && builder.getStats().elements == static_cast<size_t>(index.getNbElements());
+    std::remove(expectedPath.c_str());
+    std::remove(builtPath.c_str());
+    return same;
+}
+
+// Nombre de suites temporaires laissées dans directory
+size_t leftoverRuns(const std::string& directory) {
+    size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        count += entry.path().filename().string().rfind("indexator-run-", 0) == 0;
+    }
+    return count;
+}
+
+// Test de la construction d'instantanés par tri externe
+void testExternalBuild() {
+    std::cout << "\n=== Test ExternalBuilder ===\n";
+
+    // Plafond minimal : une suite toutes les quelques centaines de lignes
+    TEST_ASSERT((sameSnapshot<char, std::string>("exemple_index/simples-prenoms.txt", 0)), "simples-prenoms identique");
+    TEST_ASSERT((sameSnapshot<char, std::string>("exemple_index/special-case.txt", 0)), "special-case identique");
+    TEST_ASSERT((sameSnapshot<char, std::string>("exemple_index/format-incorrect.txt", 0)), "format-incorrect identique");
+    TEST_ASSERT((sameSnapshot<int, std::string>("exemple_index/complexe-notes.txt", 0)), "complexe-notes identique");
+    TEST_ASSERT((sameSnapshot<int, int>("exemple_index/complexe-nombres.txt", 0)), "complexe-nombres identique");
+    TEST_ASSERT((sameSnapshot<int, int>("exemple_index/special-case-int.txt", 0)), "special-case-int identique");
+    TEST_ASSERT((sameSnapshot<int, int>("exemple_index/complexe-nombres.txt", size_t(64) << 20)),
+                "complexe-nombres identique sans suite temporaire");
+
+    // Gros fichier : plusieurs passes de fusion
+    const std::string input = "/tmp/indexator-test-external.txt";
+    const std::string output = "/tmp/indexator-test-external.idx";
+    {
+        std::ofstream file(input);
+        for (int i = 0; i < 2000000; ++i) {
+            file << static_cast<long long>(i) * 7919 % 300007 - 150000 << " ; " << i % 1000 << "\n";
+        }
+        file << "ligne invalide\n";
+    }
+    const std::string tempDirectory = std::filesystem::temp_directory_path().string();
+    ExternalBuilder<int, int> builder(512 << 10);
+    TEST_ASSERT(builder.build(input, output), "Construction sous un plafond de 512 Ko");
+    const ExternalBuildStats& stats = builder.getStats();
+    TEST_ASSERT(stats.elements == 2000000 && stats.errors == 1 && stats.nodes == 300007, "Bilan de la construction");
+    TEST_ASSERT(stats.runs > 31 && stats.mergePasses > 0, "Suites temporaires fusionnées en plusieurs passes");
+    TEST_ASSERT(leftoverRuns(tempDirectory) == 0 && !std::ifstream(output + ".tmp").is_open(),
+                "Aucun fichier temporaire laissé");
+
+    Index<int, int> loaded, expected;
+    TEST_ASSERT(loaded.loadSnapshot(output) && expected.loadFromFile(input)
+                && loaded.getNbElements() == expected.getNbElements() && loaded.getNbNodes() == expected.getNbNodes()
+                && loaded.getElements(-150000).size() == expected.getElements(-150000).size(), "Instantané relu par loadSnapshot");
+    const std::string expectedPath = "/tmp/indexator-test-expected.idx";
+    TEST_ASSERT(expected.saveSnapshot(expectedPath) && readFile(expectedPath) == readFile(output),
+                "Même instantané que loadFromFile puis saveSnapshot");
+    std::remove(expectedPath.c_str());
+
+    // Débit avec un plafond confortable, comparé à une simple lecture du fichier
+    ExternalBuilder<int, int> roomy(size_t(8) << 20);
+    TEST_ASSERT(roomy.build(input, output) && roomy.getStats().runs > 0, "Construction sous un plafond de 8 Mo");
+    auto readStart = std::chrono::steady_clock::now();
+    size_t lines = 0;
+    {
+        std::ifstream file(input);
+        std::string line;
+        while (std::getline(file, line)) {
+            ++lines;
+        }
+    }
+    double readMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - readStart).count();
+    std::cout << "Tri externe (512 Ko, " << stats.runs << " suites, " << stats.mergePasses << " passes) : "
+              << stats.megabytesPerSecond() << " Mo/s ; (8 Mo, " << roomy.getStats().runs << " suites) : "
+              << roomy.getStats().megabytesPerSecond() << " Mo/s ; lecture seule du fichier : "
+              << stats.bytesRead / 1e3 / readMs << " Mo/s (" << lines << " lignes)" << std::endl;
+
+    TEST_ASSERT(!builder.build("/tmp/indexator-inexistant.txt", output) && loaded.loadSnapshot(output),
+                "Fichier absent : instantané existant conservé");
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+
+    // Construction, chargement puis requêtes par IndexManager, en batch comme au menu
+    const std::string snapshot = "/tmp/indexator-test-manager.idx";
+    IndexManager manager;
+    TEST_ASSERT(manager.buildSnapshot("exemple_index/simples-nombres.txt", snapshot, "ii", 1), "buildSnapshot");
+    std::istringstream fromText("load ii exemple_index/simples-nombres.txt\nget 1\ncount 1 2\n");
+    std::istringstream fromSnapshot("loadsnap ii " + snapshot + " instantane\nget 1\ncount 1 2\n"
+                                    "loadsnap cs " + snapshot + "\nloadsnap ii /tmp/indexator-inexistant.idx\n");
+    std::ostringstream textOutput, snapshotOutput;
+    manager.runBatch(fromText, textOutput);
+    TEST_ASSERT(manager.runBatch(fromSnapshot, snapshotOutput) == 2, "loadsnap : erreurs signalées");
+    std::string expectedOutput = textOutput.str();
+    expectedOutput.replace(expectedOutput.find("load"), 4, "loadsnap");
+    TEST_ASSERT(snapshotOutput.str() == expectedOutput
+                + "error\tloadsnap\tligne 4: échec du chargement de " + snapshot + "\n"
+                + "error\tloadsnap\tligne 5: impossible d'ouvrir /tmp/indexator-inexistant.idx\n",
+                "loadsnap : mêmes réponses que load");
+    TEST_ASSERT(manager.loadSnapshot(snapshot, "ii", "menu") && manager.waitForLoad()
+                && manager.getCurrentName() == "menu" && manager.getIndexNames().size() == 3,
+                "loadSnapshot en arrière-plan puis adopté");
+    TEST_ASSERT(!manager.loadSnapshot(snapshot, "xx"), "Type inconnu refusé");
+    std::remove(snapshot.c_str());
+}
+
+// Valeurs des éléments, dans l'ordre
+template <typename K, typename V, typename Elements>
+std::vector<V> valuesOf(const Elements& elements) {
+    std::vector<V> values;
+    for (const auto& element : elements) {
+        values.push_back(element.getValue());
+    }
+    return values;
+}
+
+// Même contenu, clé par clé, qu'un Index chargé du même fichier
+template <typename K, typename V>
+bool sameContent(SpillingIndex<K, V>& spilling, const Index<K, V>& expected) {
+    bool same = spilling.getNbElements() == expected.getNbElements() && spilling.getNbNodes() == expected.getNbNodes();
+    expected.forEachNode([&](const Node<K, V>& node) {
+        std::vector<V> wanted;
+        for (const auto* element : node.getAllElements()) {
+            wanted.push_back(element->getValue());
+        }
+        same = same && valuesOf<K, V>(spilling.getElements(node.getKey())) == wanted;
+    });
+    return same;
+}
+
+// Test de l'index à mémoire bornée SpillingIndex
+void testSpillingIndex() {
+    std::cout << "\n=== Test SpillingIndex ===\n";
+
+    // Petits fichiers sous un budget de quelques nœuds
+    Index<int, std::string> notes;
+    notes.loadFromFile("exemple_index/complexe-notes.txt");
+    SpillingIndex<int, std::string> spilledNotes(512);
+    TEST_ASSERT(spilledNotes.loadFromFile("exemple_index/complexe-notes.txt") && sameContent(spilledNotes, notes),
+                "complexe-notes : même contenu qu'un Index");
+    SpillStats stats = spilledNotes.getSpillStats();
+    TEST_ASSERT(stats.evictions > 0 && stats.misses > 0 && stats.spilledNodes > 0
+                && stats.residentBytes <= stats.memoryBudget, "Nœuds évincés puis relus, budget respecté");
+
+    Index<char, std::string> names;
+    names.loadFromFile("exemple_index/special-case.txt");
+    SpillingIndex<char, std::string> spilledNames(256);
+    TEST_ASSERT(spilledNames.loadFromFile("exemple_index/special-case.txt") && sameContent(spilledNames, names),
+                "special-case : même contenu qu'un Index");
+
+    // Instantané relu sous budget : jamais entièrement en mémoire
+    const std::string snapshotPath = "/tmp/indexator-test-spill.idx";
+    SpillingIndex<int, std::string> spilledSnapshot(512);
+    TEST_ASSERT(notes.saveSnapshot(snapshotPath) && spilledSnapshot.loadSnapshot(snapshotPath)
+                && sameContent(spilledSnapshot, notes), "Instantané relu : même contenu qu'un Index");
+    stats = spilledSnapshot.getSpillStats();
+    TEST_ASSERT(stats.evictions > 0 && stats.residentBytes <= stats.memoryBudget, "Instantané relu sous le budget");
+    TEST_ASSERT(!spilledNames.loadSnapshot(snapshotPath) && sameContent(spilledNames, names),
+                "Instantané d'un autre type refusé, contenu conservé");
+    std::remove(snapshotPath.c_str());
+
+    // Modifications de nœuds évincés
+    SpillingIndex<int, int> index(2048);
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < 1000; ++i) {
+        data.emplace_back(i % 100, i);
+    }
+    index.insertBatch(data);
+    TEST_ASSERT(index.getNbElements() == 1000 && index.getNbNodes() == 100 && index.getSpillStats().spilledNodes > 50,
+                "Lot inséré, la plupart des nœuds évincés");
+    stats = index.getSpillStats();
+    TEST_ASSERT(!index.contains(1000) && index.getElements(1000).empty() && index.getSpillStats().misses == stats.misses,
+                "Clé absente : aucune lecture disque");
+    std::vector<int> reread = valuesOf<int, int>(index.getElements(0));
+    TEST_ASSERT(index.contains(0) && reread.size() == 10 && index.getSpillStats().misses == stats.misses + 1,
+                "Nœud évincé relu");
+
+    index.addElement(0, -5);
+    TEST_ASSERT(index.deleteElement(Element<int, int>(1, 501)) && !index.deleteElement(Element<int, int>(1, 501)),
+                "Élément d'un nœud évincé supprimé");
+    TEST_ASSERT(index.deleteNode(2) && !index.contains(2) && !index.deleteNode(2), "Nœud évincé supprimé");
+    for (int i = 0; i < 100; ++i) {   // Évince 0 et 1 après leur modification
+        index.getElements(i);
+    }
+    std::vector<int> zero = valuesOf<int, int>(index.getElements(0));
+    std::vector<int> one = valuesOf<int, int>(index.getElements(1));
+    TEST_ASSERT(zero.size() == 11 && zero.front() == -5 && one.size() == 9
+                && std::find(one.begin(), one.end(), 501) == one.end(), "Modifications conservées après éviction");
+    TEST_ASSERT(index.getNbElements() == 990 && index.getNbNodes() == 99, "Compteurs tenus à jour");
+
+    // Un nœud relu sans modification n'est pas réécrit à sa prochaine éviction
+    stats = index.getSpillStats();
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 3; i < 100; ++i) {
+            index.getElements(i);
+        }
+    }
+    TEST_ASSERT(index.getSpillStats().spillWrites == stats.spillWrites
+                && index.getSpillStats().evictions > stats.evictions + 200, "Nœuds non modifiés évincés sans écriture");
+
+    // Fichier d'échange réécrit quand la place perdue domine
+    SpillingIndex<int, std::string> churn(4096);
+    for (int round = 0; round < 40; ++round) {
+        std::vector<std::pair<int, std::string>> batch;
+        for (int key = 0; key < 200; ++key) {
+            batch.emplace_back(key, std::string(100, static_cast<char>('a' + round % 26)));
+        }
+        churn.insertBatch(batch);
+    }
+    stats = churn.getSpillStats();
+    TEST_ASSERT(stats.compactions > 0 && stats.garbageBytes * 2 <= stats.spillFileBytes + (1 << 20),
+                "Fichier d'échange compacté");
+    std::vector<std::string> values = valuesOf<int, std::string>(churn.getElements(7));
+    TEST_ASSERT(values.size() == 40 && values.front() == std::string(100, 'a') && churn.getNbElements() == 8000,
+                "Contenu intact après compactage");
+
+    // Fichier d'échange abîmé : les compteurs suivent les éléments effectivement relus.
+    // Valeurs de 3 caractères : chaque élément occupe 11 octets, chaque clé 110, et les
+    // premières clés du lot, évincées les premières, sont en tête du fichier.
+    const std::string spillPath = "/tmp/indexator-test-spill.swap";
+    {
+        SpillingIndex<int, std::string> damaged(1024, spillPath);
+        std::vector<std::pair<int, std::string>> strings;
+        for (int i = 0; i < 1000; ++i) {
+            strings.emplace_back(i % 100, "v0" + std::to_string(i / 100));
+        }
+        damaged.insertBatch(strings);
+        TEST_ASSERT(damaged.getSpillStats().residentNodes < 10, "Presque tous les nœuds évincés");
+        auto corruptLength = [&spillPath](std::streamoff offset) {
+            std::fstream file(spillPath, std::ios::in | std::ios::out | std::ios::binary);
+            uint64_t huge = uint64_t(1) << 40;
+            file.seekp(offset);
+            file.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+        };
+        corruptLength(4 * 11);    // Cinquième valeur de la clé 0
+        corruptLength(110);       // Première valeur de la clé 1
+        TEST_ASSERT(damaged.getElements(0).size() == 4 && damaged.getNbElements() == 994,
+                    "Nœud relu en partie : compteurs ajustés");
+        TEST_ASSERT(!damaged.deleteElement(Element<int, std::string>(1, "v01")) && !damaged.contains(1)
+                    && damaged.getNbElements() == 984 && damaged.getNbNodes() == 99, "Nœud illisible retiré");
+        damaged.addElement(1, "neuf");
+        TEST_ASSERT(damaged.getElements(1).size() == 1 && damaged.getNbElements() == 985, "Clé recréée par un ajout");
+        for (int key = 2; key < 100; ++key) {   // Évince 0 et 1, réécrits depuis la mémoire
+            damaged.getElements(key);
+        }
+        TEST_ASSERT(damaged.getElements(0).size() == 4 && damaged.getElements(1).size() == 1,
+                    "Nœuds réécrits après la lecture incomplète");
+    }
+    TEST_ASSERT(!std::filesystem::exists(spillPath), "Fichier d'échange supprimé avec l'index");
+
+    // Grand index et petit ensemble de clés chaudes
+    const std::string path = "/tmp/indexator-test-spill.txt";
+    {
+        std::ofstream file(path);
+        for (int key = 0; key < 200000; ++key) {
+            for (int value = 0; value < 5; ++value) {
+                file << key << " ; " << value << "\n";
+            }
+        }
+    }
+    SpillingIndex<int, int> large(size_t(4) << 20);
+    auto start = std::chrono::steady_clock::now();
+    TEST_ASSERT(large.loadFromFile(path) && large.getNbElements() == 1000000, "Un million d'éléments chargés sous 4 Mo");
+    double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    stats = large.getSpillStats();
+    TEST_ASSERT(stats.residentBytes <= stats.memoryBudget && stats.misses == 0 && stats.spilledNodes > 150000,
+                "Fichier trié chargé sans relecture, dans le budget");
+
+    auto timeLookups = [&large](const std::vector<int>& keys) {
+        auto begin = std::chrono::steady_clock::now();
+        size_t found = 0;
+        for (int key : keys) {
+            found += large.getElements(key).size();
+        }
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+        return std::make_pair(found, us / keys.size());
+    };
+    std::vector<int> hot, cold, absent;
+    for (int i = 0; i < 200000; ++i) {
+        hot.push_back((i * 37) % 1000);
+        cold.push_back(static_cast<int>(static_cast<long long>(i) * 7919 % 200000));
+        absent.push_back(200000 + i);
+    }
+    timeLookups(hot);
+    SpillStats before = large.getSpillStats();
+    auto hotResult = timeLookups(hot);
+    SpillStats afterHot = large.getSpillStats();
+    TEST_ASSERT(hotResult.first == 1000000 && afterHot.misses == before.misses, "Clés chaudes toutes résidentes");
+    auto coldResult = timeLookups(cold);
+    TEST_ASSERT(coldResult.first == 1000000 && large.getSpillStats().misses > afterHot.misses, "Clés froides relues");
+    SpillStats afterCold = large.getSpillStats();
+    auto absentResult = timeLookups(absent);
+    TEST_ASSERT(absentResult.first == 0 && large.getSpillStats().misses == afterCold.misses
+                && large.getSpillStats().hits == afterCold.hits, "Clés absentes sans accès aux nœuds");
+    stats = large.getSpillStats();
+    std::cout << "Chargement : " << loadMs << " ms ; recherche chaude " << hotResult.second << " µs, froide "
+              << coldResult.second << " µs, absente " << absentResult.second << " µs ; "
+              << stats.hits << " succès, " << stats.misses << " défauts, " << stats.evictions << " évictions, "
+              << stats.residentNodes << " nœuds résidents (" << stats.residentBytes / 1024 << " Ko), fichier d'échange "
+              << stats.spillFileBytes / 1024 << " Ko" << std::endl;
+    std::remove(path.c_str());
+}
+
+// Écrit les paires au format des fichiers d'index
+template <typename K, typename V>
+void writePairs(const std::string& path, const std::vector<std::pair<K, V>>& pairs) {
+    std::ofstream file(path);
+    for (const auto& pair : pairs) {
+        file << pair.first << " ; " << pair.second << "\n";
+    }
+}
+
+// loadFromFile sur ces paires donne le même index qu'insertBatch
+template <typename K, typename V>
+bool loadsLikeBatch(const std::vector<std::pair<K, V>>& pairs) {
+    const std::string path = "/tmp/indexator-test-sorted.txt";
+    writePairs(path, pairs);
+    Index<K, V> loaded, batch;
+    batch.insertBatch(pairs);
+    bool same = loaded.loadFromFile(path) && loaded.getNbElements() == batch.getNbElements()
+                && loaded.getNbNodes() == batch.getNbNodes();
+    std::ostringstream expected, actual;
+    expected << batch;
+    actual << loaded;
+    std::remove(path.c_str());
+    return same && expected.str() == actual.str();
+}
+
+// Test du chargement rapide des fichiers triés et de l'analyse des champs
+void testSortedLoad() {
+    std::cout << "\n=== Test chargement de fichiers triés ===\n";
+
+    // Conversion sans copie : même résultat que la lecture par flux
+    bool sameConversion = true;
+    for (const std::string field : {"0", "-0", "+5", "+-5", "-", "", "abc", "12abc", "007", "2147483647",
+                                     "2147483648", "-2147483648", "-2147483649", "99999999999999999999", "1e5"}) {
+        int converted = 42;
+        convertField(field.data(), field.data() + field.size(), converted);
+        sameConversion = sameConversion && converted == convertFromString<int>(field);
+    }
+    TEST_ASSERT(sameConversion, "convertField et convertFromString s'accordent");
+
+    TEST_ASSERT((loadsLikeBatch<int, int>({{1, 1}, {1, 2}, {1, 2}, {2, 0}, {5, -3}, {5, 7}})), "Fichier trié");
+    TEST_ASSERT((loadsLikeBatch<int, int>({{1, 1}, {3, 2}, {2, 5}, {1, 0}, {4, 1}, {3, 1}})),
+                "Clé hors d'ordre : la suite est fusionnée");
+    TEST_ASSERT((loadsLikeBatch<int, int>({{1, 1}, {2, 5}, {2, 3}, {2, 4}, {3, 0}})),
+                "Valeur hors d'ordre dans une clé");
+    TEST_ASSERT((loadsLikeBatch<char, std::string>({{'a', "x"}, {'a', "y"}, {'b', ""}, {'a', "z"}})),
+                "Retour à une clé déjà construite");
+    TEST_ASSERT((loadsLikeBatch<int, std::string>({{-3, "b"}, {-3, "a"}})), "Hors d'ordre dès la deuxième ligne");
+
+    // Gros fichier trié, puis le même mélangé
+    const std::string path = "/tmp/indexator-test-sorted.txt";
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < 3000000; ++i) {
+        pairs.emplace_back(i / 4 - 300000, i % 4 * 10);
+    }
+    writePairs(path, pairs);
+    Index<int, int> sorted;
+    TEST_ASSERT(sorted.loadFromFile(path) && sorted.getNbElements() == 3000000 && sorted.getNbNodes() == 750000
+                && sorted.countRange(-300000, -300000) == 4, "Gros fichier trié chargé");
+    double sortedMs = sorted.getStats().loadTimeMs;
+
+    // Chemin général seul : lecture puis tri et fusion du lot entier
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Element<int, int>*> batch;
+    Index<int, int>::readElements(path, batch);
+    Index<int, int> general;
+    general.insertElements(std::move(batch));
+    double generalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::mt19937 random(7);
+    std::shuffle(pairs.begin(), pairs.end(), random);
+    writePairs(path, pairs);
+    Index<int, int> shuffled;
+    TEST_ASSERT(shuffled.loadFromFile(path) && shuffled.getNbElements() == 3000000
+                && shuffled.getElements(-300000).size() == 4, "Gros fichier mélangé chargé");
+    ThreadPool own(2);
+    Index<int, int> onOwnPool;
+    std::ostringstream shuffledText, ownPoolText;
+    TEST_ASSERT(onOwnPool.loadFromFile(path, nullptr, own), "Fichier mélangé trié sur une réserve fournie");
+    shuffledText << shuffled;
+    ownPoolText << onOwnPool;
+    TEST_ASSERT(shuffledText.str() == ownPoolText.str(), "Même index quelle que soit la réserve");
+    std::ostringstream expected, actual;
+    expected << general;
+    actual << sorted;
+    TEST_ASSERT(expected.str() == actual.str(), "Même index par les deux chemins");
+    std::cout << "3 000 000 lignes : fichier trié " << sortedMs << " ms, lecture puis tri du lot "
+              << generalMs << " ms, fichier mélangé " << shuffled.getStats().loadTimeMs << " ms" << std::endl;
+    std::remove(path.c_str());
+}
+
+int main() {
+    std::cout << "=== Programme de test pour la classe Index ===\n";
+
+    testMultiGet();
+    testInsertBatch();
+    testBulkDelete();
+    testLazyDeletion();
+    testStats();
+    testSnapshot();
+    testClone();
+    testLargeBatch();
+    testLoadProgress();
+    testBackgroundLoad();
+    testBinarySnapshot();
+    testSaveToFile();
+    testReloadFromFile();
+    testIndexRegistry();
+    testBatchMode();
+    testPagedOutput();
+    testLoadDirectory();
+    testExternalBuild();
+    testSpillingIndex();
+    testSortedLoad();
+
+    std::cout << "\nTous les tests sont terminés avec succès !\n";
+    return 0;
+}
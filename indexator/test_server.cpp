@@ -0,0 +1,245 @@
+// test_server.cpp
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <utility>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "Index.h"
+#include "Protocol.h"
+#include "IndexServer.h"
+#include "IndexClient.h"
+
+// Fonction utilitaire pour vérifier les assertions
+#define TEST_ASSERT(condition, message) \
+    if (!(condition)) { \
+        std::cerr << "ÉCHEC: " << message << " (" << __FILE__ << ":" << __LINE__ << ")" << std::endl; \
+        exit(1); \
+    } else { \
+        std::cout << "SUCCÈS: " << message << std::endl; \
+    }
+
+const std::string SocketPath = "/tmp/indexator-test-server.sock";
+
+// Serveur de test, exécuté dans son propre thread le temps d'un test
+class TestServer {
+public:
+    IndexServer server;
+
+    TestServer() {
+        server.addIndex<char, std::string>("prenoms").loadFromFile("exemple_index/simples-prenoms.txt");
+        Index<int, int>& numbers = server.addIndex<int, int>("nombres");
+        std::vector<std::pair<int, int>> data;
+        for (int i = 0; i < 100000; ++i) {
+            data.emplace_back(i % 1000, i);
+        }
+        numbers.insertBatch(data);
+        server.listenUnix(SocketPath);
+        server.listenTcp(0);
+    }
+
+    void start() {
+        thread = std::thread([this]() { server.run(); });
+    }
+
+    ~TestServer() {
+        server.stop();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+private:
+    std::thread thread;
+};
+
+// Chaque opération, sur la socket Unix et en TCP
+void testOperations() {
+    std::cout << "\n=== Test des opérations du serveur ===\n";
+
+    TestServer test;
+    test.start();
+
+    IndexClient client;
+    TEST_ASSERT(client.connectUnix(SocketPath), "Connexion par socket Unix");
+
+    RemoteStats stats;
+    TEST_ASSERT(client.stats("nombres", stats) && stats.keyTag == BinaryTag<int>::value
+                && stats.valueTag == BinaryTag<int>::value && stats.nbNodes == 1000 && stats.nbElements == 100000,
+                "STATS donne les types et la taille de l'index");
+
+    std::vector<int> values;
+    TEST_ASSERT(client.get("nombres", 7, values) && values.size() == 100 && values.front() == 7, "GET");
+    TEST_ASSERT(client.get("nombres", 5000, values) && values.empty(), "GET d'une clé absente");
+
+    std::vector<std::vector<int>> multi;
+    TEST_ASSERT(client.multiGet("nombres", std::vector<int>{1, 2000, 3}, multi) && multi.size() == 3
+                && multi[0].size() == 100 && multi[1].empty() && multi[2].size() == 100, "MULTI_GET");
+
+    std::vector<std::pair<int, int>> pairs;
+    TEST_ASSERT(client.range("nombres", 10, 12, pairs) && pairs.size() == 300
+                && pairs.front().first == 10 && pairs.back().first == 12, "RANGE");
+    TEST_ASSERT(client.count("nombres", 10, 19) == 1000, "COUNT");
+
+    TEST_ASSERT(client.add("nombres", 5000, 1) && client.count("nombres", 5000, 5000) == 1, "ADD");
+    TEST_ASSERT(client.remove("nombres", 5000, 1) && !client.remove("nombres", 5000, 1), "DELETE, puis élément absent");
+    TEST_ASSERT(client.removeNode("nombres", 7) && !client.removeNode("nombres", 7)
+                && client.count("nombres", 0, 999) == 99900, "DELETE_NODE");
+
+    std::vector<std::string> names;
+    TEST_ASSERT(client.get("prenoms", 'a', names) && !names.empty() && names.front() == "Ahmed", "Index Char/String");
+
+    TEST_ASSERT(!client.get("inconnu", 1, values) && client.getLastError().find("inconnu") != std::string::npos,
+                "Index inconnu signalé");
+    TEST_ASSERT(!client.get("nombres", 'a', values) && client.isConnected(), "Clé du mauvais type refusée");
+    TEST_ASSERT(client.count("nombres", 0, 0) == 100, "La connexion reste utilisable après une erreur");
+
+    IndexClient tcp;
+    TEST_ASSERT(tcp.connectTcp(test.server.getTcpPort()) && tcp.count("nombres", 0, 999) == 99900,
+                "Connexion TCP sur 127.0.0.1");
+}
+
+// Requêtes enchaînées sans attendre : réponses dans l'ordre, y compris au-delà de la
+// limite des réponses en attente
+void testPipelining() {
+    std::cout << "\n=== Test du pipelining ===\n";
+
+    TestServer test;
+    test.start();
+
+    IndexClient client;
+    client.connectUnix(SocketPath);
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < 1000; ++i) {
+        ids.push_back(client.request(Opcode::GET, "nombres", i));
+    }
+    TEST_ASSERT(client.flush(), "1000 requêtes envoyées d'un bloc");
+
+    bool ordered = true;
+    Response response;
+    for (int i = 0; i < 1000 && ordered; ++i) {
+        uint32_t size = 0;
+        ordered = client.receive(response) && response.id == ids[i] && response.status == ResponseStatus::OK
+                  && response.reader().get(size) && size == 100;
+    }
+    TEST_ASSERT(ordered, "Réponses reçues dans l'ordre des requêtes");
+
+    // 20 intervalles complets : environ 16 Mo de réponses
+    for (int i = 0; i < 20; ++i) {
+        client.request(Opcode::RANGE, "nombres", 0, 999);
+    }
+    client.flush();
+    bool complete = true;
+    for (int i = 0; i < 20 && complete; ++i) {
+        uint32_t size = 0;
+        complete = client.receive(response) && response.reader().get(size) && size == 100000;
+    }
+    TEST_ASSERT(complete, "Réponses volumineuses reçues en entier malgré la limite d'envoi");
+
+    // Trame de taille invalide : la connexion est fermée, le serveur continue
+    int raw = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, SocketPath.c_str());
+    uint32_t invalid = MaxFrameSize + 1;
+    char byte;
+    TEST_ASSERT(connect(raw, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0
+                && send(raw, &invalid, sizeof(invalid), 0) == sizeof(invalid) && recv(raw, &byte, 1, 0) == 0,
+                "Trame trop grande : connexion fermée");
+    close(raw);
+    IndexClient other;
+    TEST_ASSERT(other.connectUnix(SocketPath) && other.count("nombres", 0, 0) == 100, "Le serveur reste disponible");
+}
+
+// Réponses bornées : gros intervalles découpés en PARTIAL, rafale de requêtes lue trame par trame
+void testBoundedBuffers() {
+    std::cout << "\n=== Test des tampons bornés ===\n";
+
+    TestServer test;
+    Index<int, int>& large = test.server.addIndex<int, int>("grand");
+    std::vector<std::pair<int, int>> data;
+    for (int i = 0; i < 600000; ++i) {
+        data.emplace_back(i / 3, i);
+    }
+    large.insertBatch(data);
+    test.start();
+
+    IndexClient client;
+    client.connectUnix(SocketPath);
+    client.request(Opcode::RANGE, "grand", 0, 199999);
+    client.flush();
+    Response response;
+    TEST_ASSERT(client.receive(response) && response.status == ResponseStatus::PARTIAL, "Gros intervalle : réponse PARTIAL");
+    FrameReader reader = response.reader();
+    uint32_t size = 0;
+    TEST_ASSERT(reader.get(size) && size > 0 && size % 3 == 0 && response.body.size() <= MaxRangeReply + 64,
+                "Réponse bornée, faite de nœuds entiers");
+    FrameReader resume(response.body.data() + sizeof(uint32_t) + size * 2 * sizeof(int), sizeof(int));
+    int next = 0;
+    TEST_ASSERT(resume.get(next) && resume.atEnd() && next == static_cast<int>(size / 3), "Clé où reprendre");
+
+    std::vector<std::pair<int, int>> pairs;
+    bool ordered = client.range("grand", 0, 199999, pairs) && pairs.size() == 600000;
+    for (size_t i = 0; ordered && i < pairs.size(); ++i) {
+        ordered = pairs[i].first == static_cast<int>(i / 3) && pairs[i].second == static_cast<int>(i);
+    }
+    TEST_ASSERT(ordered, "range() suit les réponses PARTIAL jusqu'au bout");
+    TEST_ASSERT(client.range("grand", 1000, 1001, pairs) && pairs.size() == 6, "Petit intervalle en une réponse");
+
+    // 50000 requêtes envoyées d'un bloc (environ 1,4 Mo) : toutes servies, dans l'ordre
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < 50000; ++i) {
+        ids.push_back(client.request(Opcode::COUNT, "nombres", i % 1000, i % 1000));
+    }
+    TEST_ASSERT(client.flush(), "Rafale envoyée");
+    bool answered = true;
+    for (int i = 0; i < 50000 && answered; ++i) {
+        uint32_t count = 0;
+        answered = client.receive(response) && response.id == ids[i] && response.reader().get(count) && count == 100;
+    }
+    TEST_ASSERT(answered, "Rafale servie en entier, dans l'ordre");
+}
+
+// Débit selon la profondeur de pipeline
+void measureThroughput() {
+    std::cout << "\n=== Mesures du serveur ===\n";
+
+    TestServer test;
+    test.start();
+
+    const int nbRequests = 100000;
+    for (int depth : {1, 16, 128}) {
+        IndexClient client;
+        client.connectUnix(SocketPath);
+        Response response;
+        auto start = std::chrono::steady_clock::now();
+        for (int sent = 0; sent < nbRequests; sent += depth) {
+            for (int i = 0; i < depth; ++i) {
+                client.request(Opcode::GET, "nombres", (sent + i) % 1000);
+            }
+            client.flush();
+            for (int i = 0; i < depth; ++i) {
+                client.receive(response);
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "GET, pipeline de " << depth << " : " << static_cast<int>(nbRequests / seconds)
+                  << " requêtes/s" << std::endl;
+    }
+}
+
+int main() {
+    std::cout << "=== Programme de test pour le serveur d'index ===\n";
+
+    testOperations();
+    testPipelining();
+    testBoundedBuffers();
+    measureThroughput();
+
+    std::cout << "\nTous les tests sont terminés avec succès !\n";
+    return 0;
+}